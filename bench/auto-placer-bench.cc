@@ -0,0 +1,16 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+
+void BM_AutoPlacerAutoPlace(benchmark::State& state) {
+  const int size = state.range(0);
+  const std::vector<ShipType> fleet = BenchmarkFleet(size);
+  RandomPlacementGenerator placement_generator(1);
+
+  for (auto _ : state) {
+    Board board(size, size);
+    AutoPlacer auto_placer(board, placement_generator);
+    benchmark::DoNotOptimize(auto_placer.AutoPlace(fleet));
+  }
+}
+BENCHMARK(BM_AutoPlacerAutoPlace)->BENCHMARK_BOARD_SIZES;
@@ -0,0 +1,54 @@
+#ifndef BENCH_BENCH_FLEET_H
+#define BENCH_BENCH_FLEET_H
+
+#include <string>
+#include <vector>
+
+#include "board/auto-placer.h"
+#include "board/random-placement-generator.h"
+
+// Board sizes covered by every size dependent benchmark, from the smallest to the largest board
+// the configuration parser accepts.
+#define BENCHMARK_BOARD_SIZES Arg(5)->Arg(10)->Arg(20)->Arg(40)->Arg(80)
+
+// The default fleet, repeated until it covers roughly a fifth of a size x size board or reaches
+// max_benchmark_fleet ships.
+constexpr int max_benchmark_fleet = 200;
+
+inline std::vector<ShipType> BenchmarkFleet(const int size) {
+  const std::vector<ShipType> default_fleet = {
+    ShipType{ "Carrier", 5 },
+    ShipType{ "Battleship", 4 },
+    ShipType{ "Destroyer", 3 },
+    ShipType{ "Submarine", 3 },
+    ShipType{ "Patrol Boat", 2 }
+  };
+
+  std::vector<ShipType> fleet;
+  int area = 0;
+
+  const auto needs_more_ships = [&]() {
+    return fleet.empty() ||
+           (((area * 5) < (size * size)) && (fleet.size() < max_benchmark_fleet));
+  };
+
+  for (int copy = 1; needs_more_ships(); ++copy) {
+    for (const ShipType& ship : default_fleet) {
+      if ((ship.size <= size) && needs_more_ships()) {
+        fleet.push_back(ShipType{ ship.name + " " + std::to_string(copy), ship.size });
+        area += ship.size;
+      }
+    }
+  }
+
+  return fleet;
+}
+
+inline Board BenchmarkBoard(const int size, PlacementGenerator& placement_generator) {
+  Board board(size, size);
+  AutoPlacer auto_placer(board, placement_generator);
+  auto_placer.AutoPlace(BenchmarkFleet(size));
+  return board;
+}
+
+#endif // BENCH_BENCH_FLEET_H
@@ -0,0 +1,113 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+
+void BM_BoardShootEveryCell(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  const Board initial_board = BenchmarkBoard(size, placement_generator);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Board board(initial_board);
+    state.ResumeTiming();
+
+    for (int x = 1; x <= size; ++x) {
+      for (int y = 1; y <= size; ++y) {
+        benchmark::DoNotOptimize(board.Shoot(Location(x, y)));
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_BoardShootEveryCell)->BENCHMARK_BOARD_SIZES;
+
+// A single shot at the end of a diagonal of mines sets off a chain reaction along all of it.
+void BM_BoardShootMineChainReaction(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board initial_board = BenchmarkBoard(size, placement_generator);
+
+  for (int index = 1; index <= size; ++index) {
+    initial_board.AddMine(Location(index, index));
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Board board(initial_board);
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(board.Shoot(Location(1, 1)));
+  }
+}
+BENCHMARK(BM_BoardShootMineChainReaction)->BENCHMARK_BOARD_SIZES;
+
+void BM_BoardNotFiredLocations(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board board = BenchmarkBoard(size, placement_generator);
+
+  for (int x = 1; x <= size; x += 2) {
+    for (int y = 1; y <= size; ++y) {
+      board.Shoot(Location(x, y));
+    }
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(board.NotFiredLocations());
+  }
+}
+BENCHMARK(BM_BoardNotFiredLocations)->BENCHMARK_BOARD_SIZES;
+
+void BM_BoardAreAllShipsSunk(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board board = BenchmarkBoard(size, placement_generator);
+
+  for (int x = 1; x <= size; x += 2) {
+    for (int y = 1; y <= size; ++y) {
+      board.Shoot(Location(x, y));
+    }
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(board.AreAllShipsSunk());
+  }
+}
+BENCHMARK(BM_BoardAreAllShipsSunk)->BENCHMARK_BOARD_SIZES;
+
+// Copying a whole board to explore one shot, for comparison with snapshots.
+void BM_BoardCopy(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  const Board board = BenchmarkBoard(size, placement_generator);
+
+  for (auto _ : state) {
+    Board copy(board);
+    benchmark::DoNotOptimize(copy.Shoot(Location(1, 1)));
+  }
+}
+BENCHMARK(BM_BoardCopy)->BENCHMARK_BOARD_SIZES;
+
+// Trying one shot and taking it back, on a board where half the cells have already been fired at.
+void BM_BoardSnapshotRestore(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board board = BenchmarkBoard(size, placement_generator);
+
+  for (int x = 1; x <= size; x += 2) {
+    for (int y = 1; y <= size; ++y) {
+      board.Shoot(Location(x, y));
+    }
+  }
+
+  const Location target(2, size);
+
+  for (auto _ : state) {
+    const BoardSnapshot snapshot = board.Snapshot();
+    benchmark::DoNotOptimize(board.Shoot(target));
+    board.Restore(snapshot);
+  }
+}
+BENCHMARK(BM_BoardSnapshotRestore)->BENCHMARK_BOARD_SIZES;
@@ -0,0 +1,49 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+#include "board-renderer/board-renderer.h"
+
+void BM_BoardRendererRender(benchmark::State& state, const RenderMode render_mode) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board board = BenchmarkBoard(size, placement_generator);
+  board.AddRandomMines(placement_generator);
+
+  for (int x = 1; x <= size; x += 2) {
+    for (int y = 1; y <= size; ++y) {
+      board.Shoot(Location(x, y));
+    }
+  }
+
+  // A new renderer has no cached frame, so every iteration renders the whole board.
+  for (auto _ : state) {
+    BoardRenderer board_renderer(board);
+    board_renderer.SetMode(render_mode);
+    benchmark::DoNotOptimize(board_renderer.Render());
+  }
+}
+BENCHMARK_CAPTURE(BM_BoardRendererRender, Self, SELF)->BENCHMARK_BOARD_SIZES;
+BENCHMARK_CAPTURE(BM_BoardRendererRender, Target, TARGET)->BENCHMARK_BOARD_SIZES;
+
+// The per shot cost of the game loop: one new shot on an otherwise unchanged board.
+void BM_BoardRendererRenderAfterShot(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  const Board initial_board = BenchmarkBoard(size, placement_generator);
+  Board board(initial_board);
+  BoardRenderer board_renderer(board);
+  board_renderer.Render();
+
+  for (auto _ : state) {
+    if (board.NotFiredCount() == 0) {
+      state.PauseTiming();
+      board = initial_board;
+      board_renderer.Render();
+      state.ResumeTiming();
+    }
+
+    board.Shoot(board.NotFiredLocation(0));
+    benchmark::DoNotOptimize(board_renderer.Render());
+  }
+}
+BENCHMARK(BM_BoardRendererRenderAfterShot)->BENCHMARK_BOARD_SIZES;
@@ -0,0 +1,61 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+#include "computer-ai.h"
+
+// Plays a whole game against a fixed board and reports the cost per chosen shot.
+void BM_ComputerAiChooseNextShot(benchmark::State& state, const TargetingMode targeting_mode) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  const Board initial_board = BenchmarkBoard(size, placement_generator);
+  std::int64_t shots = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Board board(initial_board);
+    ComputerAi computer_ai(board, placement_generator);
+    computer_ai.SetTargetingMode(targeting_mode);
+    // A fixed amount of sampling per move, so MonteCarlo measures work rather than its time budget.
+    computer_ai.SetMoveAttemptBudget(FleetSampler::max_samples);
+    state.ResumeTiming();
+
+    while (!board.AreAllShipsSunk()) {
+      board.Shoot(computer_ai.ChooseNextShot());
+      ++shots;
+    }
+  }
+
+  state.SetItemsProcessed(shots);
+}
+BENCHMARK_CAPTURE(BM_ComputerAiChooseNextShot, Random, TargetingMode::Random)
+    ->BENCHMARK_BOARD_SIZES;
+BENCHMARK_CAPTURE(BM_ComputerAiChooseNextShot, Parity, TargetingMode::Parity)
+    ->BENCHMARK_BOARD_SIZES;
+BENCHMARK_CAPTURE(BM_ComputerAiChooseNextShot, ProbabilityDensity,
+                  TargetingMode::ProbabilityDensity)
+    ->BENCHMARK_BOARD_SIZES;
+// Whole games on the larger boards take minutes, so MonteCarlo stops at 20x20.
+BENCHMARK_CAPTURE(BM_ComputerAiChooseNextShot, MonteCarlo, TargetingMode::MonteCarlo)
+    ->Arg(5)->Arg(10)->Arg(20);
+
+// Fills an empty layout pool halfway through a game, with a time limit far beyond what it needs.
+void BM_FleetSamplerFillPool(benchmark::State& state) {
+  const int size = state.range(0);
+  RandomPlacementGenerator placement_generator(1);
+  Board board = BenchmarkBoard(size, placement_generator);
+
+  for (int x = 1; x <= size; x += 2) {
+    for (int y = 1; y <= size; ++y) {
+      board.Shoot(Location(x, y));
+    }
+  }
+
+  for (auto _ : state) {
+    FleetSampler fleet_sampler(board, placement_generator);
+    fleet_sampler.Update(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    benchmark::DoNotOptimize(fleet_sampler.SampleCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * FleetSampler::max_samples);
+}
+BENCHMARK(BM_FleetSamplerFillPool)->BENCHMARK_BOARD_SIZES;
@@ -0,0 +1,30 @@
+#include <iterator>
+
+#include "benchmark/benchmark.h"
+
+#include "shared.h"
+
+void BM_ParseCoordinate(benchmark::State& state) {
+  const char* inputs[] = { "A2", "2a", "AB12", "cb80", "17J", "B", "ZZ99", "x 7" };
+  Coordinate coordinate;
+
+  for (auto _ : state) {
+    for (const char* input : inputs) {
+      benchmark::DoNotOptimize(ParseCoordinate(input, coordinate));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * std::size(inputs));
+}
+BENCHMARK(BM_ParseCoordinate);
+
+void BM_CoordinateLetters(benchmark::State& state) {
+  for (auto _ : state) {
+    for (int column = 1; column <= max_coordinate; ++column) {
+      benchmark::DoNotOptimize(CoordinateLetters(column));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * max_coordinate);
+}
+BENCHMARK(BM_CoordinateLetters);
@@ -0,0 +1,41 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+#include "simulation/game-simulator.h"
+
+Configuration BenchmarkSimulationConfiguration(const int size) {
+  Configuration configuration;
+  configuration.board_width = size;
+  configuration.board_height = size;
+  configuration.ship_types = BenchmarkFleet(size);
+  return configuration;
+}
+
+// Random vs Random games, which sizes in GameSimulator::FixedBoardSizes play on a FixedBoard.
+void BM_GameSimulatorFixedBoard(benchmark::State& state) {
+  const Configuration configuration = BenchmarkSimulationConfiguration(state.range(0));
+  RandomPlacementGenerator placement_generator(1);
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(game_simulator.PlayGame(NORMAL));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GameSimulatorFixedBoard)->Arg(8)->Arg(10)->Arg(20);
+
+// The same games with the generator behind a PlacementGenerator, which always plays on Board.
+void BM_GameSimulatorBoard(benchmark::State& state) {
+  const Configuration configuration = BenchmarkSimulationConfiguration(state.range(0));
+  RandomPlacementGenerator random_placement_generator(1);
+  PlacementGenerator& placement_generator = random_placement_generator;
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(game_simulator.PlayGame(NORMAL));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GameSimulatorBoard)->Arg(8)->Arg(10)->Arg(20);
@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "board/auto-placer.h"
+#include "board/random-placement-generator.h"
+#include "journal/game-journal.h"
+#include "journal/journal-reader.h"
+
+constexpr int journal_bench_games = 100000;
+constexpr int journal_bench_ship_types = 5;
+
+// A journal of journal_bench_games games, each a random 10x10 game with about sixty shots a side,
+// written once per run and shared by every benchmark.
+const std::string& BenchmarkJournalPath() {
+  static const std::string path = [] {
+    const std::string journal_path = "/tmp/journal-bench.journal";
+    std::remove(journal_path.c_str());
+
+    Configuration configuration;
+    configuration.board_width = 10;
+    configuration.board_height = 10;
+    configuration.ship_types = { ShipType{ "Carrier", 5 }, ShipType{ "Battleship", 4 },
+                                 ShipType{ "Destroyer", 3 }, ShipType{ "Submarine", 3 },
+                                 ShipType{ "Patrol Boat", 2 } };
+
+    RandomPlacementGenerator placement_generator(1);
+    Board board_1(10, 10);
+    Board board_2(10, 10);
+    AutoPlacer(board_1, placement_generator).AutoPlace(configuration.ship_types);
+    AutoPlacer(board_2, placement_generator).AutoPlace(configuration.ship_types);
+
+    GameRecorder game_recorder;
+    game_recorder.Begin(configuration, 1, RandomEngine::MersenneTwister, NORMAL, board_1, board_2);
+
+    for (int shot = 0; shot < 60; ++shot) {
+      const Location location_1 = placement_generator.ChooseNotFiredLocation(board_2);
+      board_2.Shoot(location_1);
+      game_recorder.RecordShot(board_2, location_1);
+
+      const Location location_2 = placement_generator.ChooseNotFiredLocation(board_1);
+      board_1.Shoot(location_2);
+      game_recorder.RecordShot(board_1, location_2);
+    }
+
+    game_recorder.Finish(1);
+
+    GameJournal game_journal(journal_path);
+
+    for (int game = 0; game < journal_bench_games; ++game) {
+      game_journal.Append(game_recorder.GetRecord());
+    }
+
+    return journal_path;
+  }();
+
+  return path;
+}
+
+void BM_JournalOpen(benchmark::State& state) {
+  const std::string& path = BenchmarkJournalPath();
+
+  for (auto _ : state) {
+    const JournalReader journal_reader(path);
+    benchmark::DoNotOptimize(journal_reader.GetGameCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * journal_bench_games);
+}
+BENCHMARK(BM_JournalOpen)->Unit(benchmark::kMillisecond);
+
+void BM_JournalScanSummaries(benchmark::State& state) {
+  const JournalReader journal_reader(BenchmarkJournalPath());
+  GameSummary summary;
+
+  for (auto _ : state) {
+    std::int64_t total_shots = 0;
+
+    for (int game = 0; game < journal_reader.GetGameCount(); ++game) {
+      journal_reader.ReadSummary(game, summary);
+      total_shots += summary.shot_count;
+    }
+
+    benchmark::DoNotOptimize(total_shots);
+  }
+
+  state.SetItemsProcessed(state.iterations() * journal_bench_games);
+}
+BENCHMARK(BM_JournalScanSummaries)->Unit(benchmark::kMillisecond);
+
+void BM_JournalScanGames(benchmark::State& state) {
+  const JournalReader journal_reader(BenchmarkJournalPath());
+  GameRecord record;
+
+  for (auto _ : state) {
+    std::int64_t hits = 0;
+
+    for (int game = 0; game < journal_reader.GetGameCount(); ++game) {
+      journal_reader.ReadGame(game, journal_bench_ship_types, record);
+
+      for (const JournalShot& shot : record.shots) {
+        hits += (shot.result == ShotResult::Hit);
+      }
+    }
+
+    benchmark::DoNotOptimize(hits);
+  }
+
+  state.SetItemsProcessed(state.iterations() * journal_bench_games);
+}
+BENCHMARK(BM_JournalScanGames)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,23 @@
+#include "benchmark/benchmark.h"
+
+#include "board/random-placement-generator.h"
+
+// state.range(0) picks the engine: 0 for the Mersenne Twister, 1 for Philox.
+void BM_RandomPlacementGeneratorChooseIndex(benchmark::State& state) {
+  RandomPlacementGenerator placement_generator(1, static_cast<RandomEngine>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(placement_generator.ChooseIndex(100));
+  }
+}
+BENCHMARK(BM_RandomPlacementGeneratorChooseIndex)->Arg(0)->Arg(1);
+
+void BM_RandomPlacementGeneratorDiscard(benchmark::State& state) {
+  RandomPlacementGenerator placement_generator(1, static_cast<RandomEngine>(state.range(0)));
+
+  for (auto _ : state) {
+    placement_generator.Discard(1 << 20);
+    benchmark::DoNotOptimize(placement_generator.ChooseIndex(100));
+  }
+}
+BENCHMARK(BM_RandomPlacementGeneratorDiscard)->Arg(0)->Arg(1);
@@ -0,0 +1,37 @@
+#include "benchmark/benchmark.h"
+
+#include "bench-fleet.h"
+#include "board/window-counts.h"
+
+// Counts the windows of every default ship length over a board with every third cell missed.
+void BM_CountOpenWindows(benchmark::State& state, const WindowCountKernel kernel) {
+  if (!IsWindowCountKernelSupported(kernel)) {
+    state.SkipWithError("kernel not supported on this processor");
+    return;
+  }
+
+  const int size = state.range(0);
+  BitPlane blocked;
+
+  for (int y = 1; y <= size; ++y) {
+    for (int x = 1; x <= size; ++x) {
+      if (((x + (y * 2)) % 3) == 0) {
+        blocked.Set(x, y);
+      }
+    }
+  }
+
+  const BitPlane blocked_columns = TransposeBitPlane(blocked, size, size);
+  std::vector<int> counts;
+
+  for (auto _ : state) {
+    for (const int length : { 2, 3, 4, 5 }) {
+      CountOpenWindows(blocked, blocked_columns, size, size, length, counts, kernel);
+      benchmark::DoNotOptimize(counts.data());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * size * size * 4);
+}
+BENCHMARK_CAPTURE(BM_CountOpenWindows, Scalar, WindowCountKernel::Scalar)->Arg(10)->Arg(80);
+BENCHMARK_CAPTURE(BM_CountOpenWindows, Avx2, WindowCountKernel::Avx2)->Arg(10)->Arg(80);
@@ -1,10 +1,14 @@
-#include <memory>
+#include <algorithm>
 
 #include "board-renderer.h"
+#include "profiling/profiler.h"
 #include "shared.h"
 
 void BoardRenderer::SetMode(const RenderMode render_mode) {
-  this->render_mode = render_mode;
+  if (this->render_mode != render_mode) {
+    this->render_mode = render_mode;
+    is_frame_valid = false;
+  }
 }
 
 std::string_view NewLine() {
@@ -46,8 +50,9 @@ std::string Pad(const std::string& string, const int required_size) {
   return string + std::string(padding_letters_required, ' ');
 }
 
-std::string BoatToString(const Boat& boat) {
-  return std::string() + boat.GetName().at(0);
+// Boats are drawn as the first letter of their type's name.
+std::string BoatToString(const FleetRegistry& fleet_registry, const ShipTypeId ship_type_id) {
+  return std::string(1, fleet_registry.GetName(ship_type_id).at(0));
 }
 
 bool BoardRenderer::ShouldRenderWide(const int column) const {
@@ -58,7 +63,7 @@ bool BoardRenderer::ShouldRenderWide(const int column) const {
   for (int row = 1; row <= board.GetHeight(); ++row) {
     const Location location(column, row);
 
-    const bool is_wide_cell = board.IsMine(location) && board.GetBoat(location).has_value();
+    const bool is_wide_cell = board.IsMine(location) && board.GetShipTypeId(location).has_value();
     const bool will_render_wide = !board.IsHit(location);
 
     if (is_wide_cell && will_render_wide) {
@@ -69,74 +74,144 @@ bool BoardRenderer::ShouldRenderWide(const int column) const {
   return false;
 }
 
-std::string BoardRenderer::Render() const {
-  const int width = board.GetWidth();
-  const int height = board.GetHeight();
+int BoardRenderer::ColumnWidth(const int column) const {
+  constexpr static int wide_render_chars = 3;
+  const int max_column_identifier_chars = CoordinateLetters(board.GetWidth()).size();
 
-  const int max_column_identifier_chars = CoordinateToLetter(board.GetWidth()).size();
-  const int max_row_identifier_chars = std::to_string(height).size();
+  return ShouldRenderWide(column) ?
+      std::max(max_column_identifier_chars, wide_render_chars) :
+      max_column_identifier_chars;
+}
 
-  auto rows = std::make_unique<std::string[]>(height + 1);
+std::string BoardRenderer::CellMarker(const Location location) const {
+  std::string cell_marker;
 
-  // Column 0, Row 0
-  rows[0] += std::string(max_row_identifier_chars, ' ');
+  if (board.HasShot(location)) {
+    if (board.IsHit(location)) {
+      cell_marker = HitMarker();
+    } else {
+      cell_marker = MissMarker();
+    }
+  } else if (render_mode == SELF) {
+    const std::optional<ShipTypeId> ship_type_id = board.GetShipTypeId(location);
 
-  // Column 0
-  for (int row = 1; row <= height; ++row) {
-    rows[row] += Pad(std::to_string(row), max_row_identifier_chars);
+    if (ship_type_id.has_value()) {
+      cell_marker = BoatToString(board.GetFleetRegistry(), *ship_type_id);
+
+      if (board.IsMine(location)) {
+        cell_marker += "/";
+        cell_marker += MineMarker();
+      }
+    } else if (board.IsMine(location)) {
+      cell_marker = MineMarker();
+    } else {
+      cell_marker = BlankCell();
+    }
+  } else {
+    cell_marker = BlankCell();
   }
 
-  for (int column = 1; column <= width; ++column) {
-    constexpr static int wide_render_chars = 3;
-    const int max_render_width = ShouldRenderWide(column) ?
-        std::max(max_column_identifier_chars, wide_render_chars) :
-        max_column_identifier_chars;
+  return cell_marker;
+}
 
-    // Row 0
-    rows[0] += CellSeparator();
-    rows[0] += Pad(CoordinateToLetter(column), max_render_width);
+const std::string& BoardRenderer::Render() const {
+  PROFILE_SCOPE(ProfilePoint::BoardRendererRender);
+  const std::vector<Location>& changed_cells = board.GetChangedCells();
 
-    for (int row = 1; row <= height; ++row) {
-      const Location location(column, row);
+  if (!is_frame_valid || (rendered_reset_count != board.GetResetCount())) {
+    RenderAll();
+  } else if (rendered_changes != static_cast<int>(changed_cells.size())) {
+    std::vector<bool> dirty_columns(board.GetWidth() + 1, false);
+    std::fill(dirty_rows.begin(), dirty_rows.end(), false);
 
-      std::string cell_marker;
+    for (int change = rendered_changes; change < static_cast<int>(changed_cells.size()); ++change) {
+      dirty_columns[changed_cells[change].x] = true;
+      dirty_rows[changed_cells[change].y] = true;
+    }
 
-      if (board.HasShot(location)) {
-        if (board.IsHit(location)) {
-          cell_marker = HitMarker();
-        } else {
-          cell_marker = MissMarker();
-        }
-      } else if (render_mode == SELF) {
-        std::optional<Boat> boat = board.GetBoat(location);
-
-        if (boat.has_value()) {
-          cell_marker = BoatToString(boat.value());
-
-          if (board.IsMine(location)) {
-            cell_marker += "/";
-            cell_marker += MineMarker();
-          }
-        } else if (board.IsMine(location)) {
-          cell_marker = MineMarker();
-        } else {
-          cell_marker = BlankCell();
+    bool widths_changed = false;
+
+    for (int column = 1; column <= board.GetWidth(); ++column) {
+      if (dirty_columns[column]) {
+        const int column_width = ColumnWidth(column);
+        widths_changed = widths_changed || (column_width != column_widths[column]);
+        column_widths[column] = column_width;
+      }
+    }
+
+    if (widths_changed) {
+      RenderAll();
+    } else {
+      for (int row = 1; row <= board.GetHeight(); ++row) {
+        if (dirty_rows[row]) {
+          RenderRow(row);
         }
-      } else {
-        cell_marker = BlankCell();
       }
 
-      rows[row] += CellSeparator();
-      rows[row] += Pad(cell_marker, max_render_width);
+      AssembleFrame();
     }
   }
 
-  std::string render;
+  rendered_changes = changed_cells.size();
+  return frame;
+}
+
+void BoardRenderer::RenderAll() const {
+  const int width = board.GetWidth();
+  const int height = board.GetHeight();
+
+  column_widths.assign(width + 1, 0);
+  rows.assign(height + 1, std::string());
+  dirty_rows.assign(height + 1, false);
+
+  for (int column = 1; column <= width; ++column) {
+    column_widths[column] = ColumnWidth(column);
+  }
+
+  RenderHeader();
 
-  for (int row = 0; row <= height; ++row) {
-    render += rows[row];
-    render += "\n";
+  for (int row = 1; row <= height; ++row) {
+    RenderRow(row);
   }
 
-  return render;
+  AssembleFrame();
+
+  is_frame_valid = true;
+  rendered_reset_count = board.GetResetCount();
+}
+
+void BoardRenderer::RenderHeader() const {
+  const int max_row_identifier_chars = std::to_string(board.GetHeight()).size();
+
+  // Column 0, Row 0
+  std::string& header = rows[0];
+  header = std::string(max_row_identifier_chars, ' ');
+
+  // Row 0
+  for (int column = 1; column <= board.GetWidth(); ++column) {
+    header += CellSeparator();
+    header += Pad(CoordinateToLetter(column), column_widths[column]);
+  }
+}
+
+void BoardRenderer::RenderRow(const int row) const {
+  const int max_row_identifier_chars = std::to_string(board.GetHeight()).size();
+
+  // Column 0
+  std::string& line = rows[row];
+  line = Pad(std::to_string(row), max_row_identifier_chars);
+
+  for (int column = 1; column <= board.GetWidth(); ++column) {
+    line += CellSeparator();
+    line += Pad(CellMarker(Location(column, row)), column_widths[column]);
+  }
+}
+
+void BoardRenderer::AssembleFrame() const {
+  frame.clear();
+
+  for (const std::string& row : rows) {
+    frame += row;
+    frame += NewLine();
+  }
 }
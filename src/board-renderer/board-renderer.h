@@ -3,6 +3,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "board/board.h"
 
@@ -11,18 +12,36 @@ enum RenderMode {
   TARGET
 };
 
+// Keeps the last rendered frame, one string per row, and on the next render only rebuilds the rows
+// holding cells the board reports as changed since then. Every row is rebuilt when a column's
+// width changes, the render mode changes or the board is reset.
 class BoardRenderer {
 public:
   explicit BoardRenderer(const Board& board) : board(board), render_mode(SELF) {}
 
   void SetMode(const RenderMode render_mode);
-  std::string Render() const;
+  const std::string& Render() const;
 
 private:
   bool ShouldRenderWide(const int column) const;
+  int ColumnWidth(const int column) const;
+  std::string CellMarker(const Location location) const;
+  void RenderAll() const;
+  void RenderHeader() const;
+  void RenderRow(const int row) const;
+  void AssembleFrame() const;
 
   const Board& board;
   RenderMode render_mode;
+
+  // Frame cache, rebuilt lazily by Render.
+  mutable bool is_frame_valid = false;
+  mutable int rendered_reset_count = 0;
+  mutable int rendered_changes = 0;
+  mutable std::vector<int> column_widths;
+  mutable std::vector<std::string> rows;
+  mutable std::vector<bool> dirty_rows;
+  mutable std::string frame;
 };
 
 #endif // SRC_BOARD_RENDERER_H
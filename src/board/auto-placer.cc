@@ -1,29 +1,247 @@
 #include "auto-placer.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "profiling/profiler.h"
+
+static_assert(BitPlane::words_per_row == 2, "lines are handled as a low and a high word");
+
+// The bits of the given word of a row that hold its first line_length cells.
+std::uint64_t LineWordMask(const int line_length, const int word) {
+  const int bits = std::min(std::max(line_length - (word * 64), 0), 64);
+
+  return (bits == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << bits) - 1);
+}
+
 bool AutoPlacer::AutoPlace(const std::vector<ShipType>& boats) {
-  Board test_board(board);
+  PROFILE_SCOPE(ProfilePoint::AutoPlacerAutoPlace);
+  return Place(boats) == AutoPlaceResult::Placed;
+}
 
-  for (int index = 0; index < 10000; ++index) {
-    bool success = false;
+AutoPlaceResult AutoPlacer::Place(const std::vector<ShipType>& boats) {
+  std::vector<int> order(boats.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&boats](const int lhs, const int rhs) {
+    return boats[lhs].size > boats[rhs].size;
+  });
 
-    for (const ShipType& ship_type : boats) {
-      success = test_board.AddBoat(
-          ship_type,
-          placement_generator.GenerateLocation(test_board.GetWidth(), test_board.GetHeight()),
-          placement_generator.GenerateOrientation());
+  ships.clear();
+  for (const int index : order) {
+    ships.push_back(boats[index]);
+  }
 
-      if (!success) {
-        test_board = Board(board);
-        break;
+  placements.assign(ships.size(), Placement{ Location(), Orientation::Horizontal });
+  occupied_cells.Reset();
+  occupied_columns.Reset();
+  free_cells = 0;
+  search_steps = 0;
+  is_search_limit_reached = false;
+  remaining_area = 0;
+
+  for (int x = 1; x <= board.GetWidth(); ++x) {
+    for (int y = 1; y <= board.GetHeight(); ++y) {
+      if (board.GetBoat(Location(x, y)).has_value()) {
+        occupied_cells.Set(x, y);
+        occupied_columns.Set(y, x);
+      } else {
+        ++free_cells;
       }
     }
+  }
+
+  for (const ShipType& ship : ships) {
+    remaining_area += ship.size;
+  }
+
+  if (!PlaceFrom(0)) {
+    return is_search_limit_reached ? AutoPlaceResult::SearchLimitReached
+                                   : AutoPlaceResult::Impossible;
+  }
+
+  // Added in the caller's order so the board lists its ships the way they were given.
+  std::vector<Placement> placements_by_boat(boats.size(),
+                                            Placement{ Location(), Orientation::Horizontal });
+  for (int ship = 0; ship < static_cast<int>(order.size()); ++ship) {
+    placements_by_boat[order[ship]] = placements[ship];
+  }
+
+  for (int boat = 0; boat < static_cast<int>(boats.size()); ++boat) {
+    board.AddBoat(boats[boat], placements_by_boat[boat].location,
+                  placements_by_boat[boat].orientation);
+  }
+
+  return AutoPlaceResult::Placed;
+}
 
-    if (success) {
-      board = test_board;
+bool AutoPlacer::PlaceFrom(const int ship) {
+  if (ship == static_cast<int>(ships.size())) {
+    return true;
+  }
+
+  if (remaining_area > free_cells) {
+    return false;
+  }
+
+  const int size = ships[ship].size;
+
+  // A position drawn uniformly over the whole board and kept only when it fits is a uniform draw
+  // over the legal positions, so a few proposals are tried before enumerating all of them.
+  Placement proposal{ Location(), Orientation::Horizontal };
+  bool proposal_fits = false;
+
+  for (int attempt = 0; (attempt < max_proposals) && !proposal_fits; ++attempt) {
+    proposal = Placement{ placement_generator.GenerateLocation(board.GetWidth(),
+                                                               board.GetHeight()),
+                          placement_generator.GenerateOrientation() };
+
+    if (size == 1) {
+      proposal.orientation = Orientation::Horizontal;
+    }
+
+    proposal_fits = (proposal.location.x >= 1) && (proposal.location.y >= 1) &&
+                    Fits(proposal, size);
+  }
+
+  remaining_area -= size;
+  free_cells -= size;
+
+  if (proposal_fits) {
+    ++search_steps;
+    SetCells(proposal, size, true);
+
+    if (PlaceFrom(ship + 1)) {
+      placements[ship] = proposal;
       return true;
     }
+
+    SetCells(proposal, size, false);
   }
 
-  board = test_board;
+  std::vector<Placement> candidates = LegalPlacements(size);
+  search_steps += candidates.size();
+
+  if (proposal_fits) {
+    candidates.erase(std::find_if(candidates.begin(), candidates.end(),
+                                  [&proposal](const Placement& candidate) {
+                                    return (candidate.location == proposal.location) &&
+                                           (candidate.orientation == proposal.orientation);
+                                  }));
+  }
+
+  for (int index = 0; index < static_cast<int>(candidates.size()); ++index) {
+    if (++search_steps > max_search_steps) {
+      is_search_limit_reached = true;
+      break;
+    }
+
+    // Lazily shuffles the untried candidates, one pick at a time.
+    const int pick = index + placement_generator.ChooseIndex(candidates.size() - index);
+    std::swap(candidates[index], candidates[pick]);
+
+    SetCells(candidates[index], size, true);
+
+    if (PlaceFrom(ship + 1)) {
+      placements[ship] = candidates[index];
+      return true;
+    }
+
+    SetCells(candidates[index], size, false);
+  }
+
+  remaining_area += size;
+  free_cells += size;
+
   return false;
 }
+
+std::vector<AutoPlacer::Placement> AutoPlacer::LegalPlacements(const int size) const {
+  std::vector<Placement> candidates;
+  AddLinePlacements(occupied_cells, board.GetWidth(), board.GetHeight(), size,
+                    Orientation::Horizontal, candidates);
+
+  // A single cell ship covers the same cell either way, so it is only counted once.
+  if (size > 1) {
+    AddLinePlacements(occupied_columns, board.GetHeight(), board.GetWidth(), size,
+                      Orientation::Vertical, candidates);
+  }
+
+  return candidates;
+}
+
+// Adds the positions of a size cell ship along each of the line_count rows of occupied_lines,
+// which are line_length cells long. A position starts on a cell when it and the size - 1 cells
+// after it are free, which is found for a whole row at once by shifting and masking its bits.
+void AutoPlacer::AddLinePlacements(const BitPlane& occupied_lines,
+                                   const int line_length,
+                                   const int line_count,
+                                   const int size,
+                                   const Orientation orientation,
+                                   std::vector<Placement>& candidates) const {
+  const std::uint64_t low_valid = LineWordMask(line_length, 0);
+  const std::uint64_t high_valid = LineWordMask(line_length, 1);
+
+  for (int line = 1; line <= line_count; ++line) {
+    std::uint64_t shifted_low = ~occupied_lines.Word(line, 0) & low_valid;
+    std::uint64_t shifted_high = ~occupied_lines.Word(line, 1) & high_valid;
+    std::uint64_t start_low = shifted_low;
+    std::uint64_t start_high = shifted_high;
+
+    for (int offset = 1; offset < size; ++offset) {
+      shifted_low = (shifted_low >> 1) | (shifted_high << 63);
+      shifted_high >>= 1;
+      start_low &= shifted_low;
+      start_high &= shifted_high;
+    }
+
+    for (int cell = 1; cell <= line_length; ++cell) {
+      const std::uint64_t starts = (cell <= 64) ? start_low : start_high;
+
+      if ((starts >> ((cell - 1) % 64)) & 1) {
+        candidates.push_back(Placement{ (orientation == Orientation::Horizontal)
+                                            ? Location(cell, line)
+                                            : Location(line, cell),
+                                        orientation });
+      }
+    }
+  }
+}
+
+bool AutoPlacer::Fits(const Placement& placement, const int size) const {
+  const bool vertical = placement.orientation == Orientation::Vertical;
+  const int end_x = placement.location.x + (vertical ? 0 : size - 1);
+  const int end_y = placement.location.y + (vertical ? size - 1 : 0);
+
+  if ((end_x > board.GetWidth()) || (end_y > board.GetHeight())) {
+    return false;
+  }
+
+  for (int offset = 0; offset < size; ++offset) {
+    const int x = placement.location.x + (vertical ? 0 : offset);
+    const int y = placement.location.y + (vertical ? offset : 0);
+
+    if (occupied_cells.Test(x, y)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AutoPlacer::SetCells(const Placement& placement, const int size, const bool occupied) {
+  const bool vertical = placement.orientation == Orientation::Vertical;
+
+  for (int offset = 0; offset < size; ++offset) {
+    const int x = placement.location.x + (vertical ? 0 : offset);
+    const int y = placement.location.y + (vertical ? offset : 0);
+
+    if (occupied) {
+      occupied_cells.Set(x, y);
+      occupied_columns.Set(y, x);
+    } else {
+      occupied_cells.Clear(x, y);
+      occupied_columns.Clear(y, x);
+    }
+  }
+}
@@ -4,16 +4,61 @@
 #include "board.h"
 #include "placement-generator.h"
 
+enum class AutoPlaceResult {
+  Placed,
+  // Definitive: the search tried every arrangement, so no arrangement of the ships fits on the
+  // board's free cells.
+  Impossible,
+  // Not definitive: the search used up max_search_steps before finding an arrangement or trying
+  // them all, so one may still exist.
+  SearchLimitReached
+};
+
+// Places ships largest first, only ever trying positions that are free on the board, and
+// backtracks to the previous ship when one no longer fits. Each ship's position is drawn uniformly
+// from its legal positions: a location proposed by the placement generator is used when it fits,
+// and only after max_proposals misses are the legal positions listed and one chosen. Positions
+// are listed a row of cells at a time with bit masks, and every position listed counts as a
+// search step, so the search does a bounded amount of work on any board size.
 class AutoPlacer {
 public:
+  static constexpr int max_search_steps = 1000000;
+  static constexpr int max_proposals = 16;
+
   explicit AutoPlacer(Board& board, PlacementGenerator& placement_generator)
     : board(board), placement_generator(placement_generator) {}
 
   bool AutoPlace(const std::vector<ShipType>& boats);
+  AutoPlaceResult Place(const std::vector<ShipType>& boats);
 
 private:
+  struct Placement {
+    Location location;
+    Orientation orientation;
+  };
+
+  bool PlaceFrom(const int ship);
+  std::vector<Placement> LegalPlacements(const int size) const;
+  void AddLinePlacements(const BitPlane& occupied_lines, const int line_length,
+                         const int line_count, const int size, const Orientation orientation,
+                         std::vector<Placement>& candidates) const;
+  bool Fits(const Placement& placement, const int size) const;
+  void SetCells(const Placement& placement, const int size, const bool occupied);
+
   Board& board;
   PlacementGenerator& placement_generator;
+
+  // Search state, only valid during Place.
+  std::vector<ShipType> ships;
+  std::vector<Placement> placements;
+  BitPlane occupied_cells;
+  // occupied_cells with column x stored as row x, for listing vertical positions.
+  BitPlane occupied_columns;
+  int free_cells = 0;
+  int remaining_area = 0;
+  int search_steps = 0;
+  // Set when the search stopped with positions left untried.
+  bool is_search_limit_reached = false;
 };
 
 #endif // SRC_BOARD_AUTO_PLACER_H
@@ -0,0 +1,47 @@
+#ifndef SRC_BOARD_BIT_PLANE_H
+#define SRC_BOARD_BIT_PLANE_H
+
+#include <array>
+#include <cstdint>
+
+// One bit per cell of a board of at most max_size x max_size cells. Each row is stored in a fixed
+// number of 64-bit words so that a whole row can be read or masked without touching other rows.
+// Coordinates are 1-based like Location; callers are expected to range check before access.
+class BitPlane {
+public:
+  static constexpr int max_size = 80;
+  static constexpr int words_per_row = (max_size + 63) / 64;
+
+  bool Test(const int x, const int y) const {
+    return (words[WordIndex(x, y)] & BitMask(x)) != 0;
+  }
+
+  void Set(const int x, const int y) {
+    words[WordIndex(x, y)] |= BitMask(x);
+  }
+
+  void Clear(const int x, const int y) {
+    words[WordIndex(x, y)] &= ~BitMask(x);
+  }
+
+  void Reset() {
+    words.fill(0);
+  }
+
+  std::uint64_t Word(const int y, const int word) const {
+    return words[((y - 1) * words_per_row) + word];
+  }
+
+private:
+  static int WordIndex(const int x, const int y) {
+    return ((y - 1) * words_per_row) + ((x - 1) / 64);
+  }
+
+  static std::uint64_t BitMask(const int x) {
+    return std::uint64_t(1) << ((x - 1) % 64);
+  }
+
+  std::array<std::uint64_t, max_size * words_per_row> words{};
+};
+
+#endif // SRC_BOARD_BIT_PLANE_H
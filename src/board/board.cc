@@ -1,60 +1,29 @@
 #include "board.h"
 
-#include <algorithm>
+#include <stdexcept>
 
 #include "placement-generator.h"
+#include "profiling/profiler.h"
 #include "shared.h"
 
-char VerifyInRange(char character) {
-  if ((character >= 'a') && (character <= 'z')) {
-    character += ('A' - 'a'); // Convert to capital letter
-  }
-
-  if ((character < 'A') || (character > 'Z')) {
-    throw std::runtime_error("Letter index out of range");
-  }
-
-  return character;
-}
-
-int Base26Value(const char character)  {
-  // Subtract ASCII alphabet to get pure character index in the alphabet
-  return character - ('A' - 1);
-}
-
 int LetterIndex::ToInt() const {
-  const int size = value.size();
-
-  if (size == 0) {
-    throw std::runtime_error("Letter index empty");
-  }
-
-  if (size > 2) {
-    throw std::runtime_error("Letter index undefined");
-  }
-
-  const int character1_value = Base26Value(VerifyInRange(value[0]));
-
-  if (size == 1) {
-    return character1_value;
-  }
-
-  const int character2_value = Base26Value(VerifyInRange(value[1]));
-
-  const int total_value = (26 * character1_value) + character2_value;
-
-  if (total_value > 80)  {
-    throw std::runtime_error("Letter index value too big");
+  int column = 0;
+
+  switch (ParseCoordinateLetters(value, column)) {
+    case CoordinateError::None:
+      return column;
+    case CoordinateError::ColumnOutOfRange:
+      throw std::runtime_error("Letter index value too big");
+    default:
+      throw std::runtime_error("Letter index undefined");
   }
-
-  return total_value;
 }
 
 std::string Location::ToString() const {
-  const std::string x_string = CoordinateToLetter(x);
-  const std::string y_string = std::to_string(y);
+  std::string text = CoordinateToLetter(x);
+  text += std::to_string(y);
 
-  return x_string + y_string;
+  return text;
 }
 
 bool Boat::operator==(const Boat& rhs) const {
@@ -77,16 +46,16 @@ ShipType Boat::GetShipType() const {
   return type;
 }
 
-std::vector<Location> AllLocationsFor(const ShipType& ship, const Location start_location,
+std::vector<Location> AllLocationsFor(const int size, const Location start_location,
                                       const Orientation orientation) {
   std::vector<Location> locations;
 
   if (orientation == Orientation::Vertical) {
-    for (int index = 0; index < ship.size; ++index) {
+    for (int index = 0; index < size; ++index) {
       locations.emplace_back(Location(start_location.x, start_location.y + index));
     }
   } else {
-    for (int index = 0; index < ship.size; ++index) {
+    for (int index = 0; index < size; ++index) {
       locations.emplace_back(Location(start_location.x + index, start_location.y));
     }
   }
@@ -94,22 +63,44 @@ std::vector<Location> AllLocationsFor(const ShipType& ship, const Location start
   return locations;
 }
 
+Board::Board(const int width, const int height) : Board(width, height, FleetRegistry()) {}
+
+Board::Board(const int width, const int height, const FleetRegistry& fleet_registry)
+  : width(std::min(width, BitPlane::max_size)),
+    height(std::min(height, BitPlane::max_size)),
+    fleet_registry(fleet_registry) {
+  for (int y = 1; y <= this->height; ++y) {
+    for (int x = 1; x <= this->width; ++x) {
+      AddNotFiredCell(CellIndex(Location(x, y)));
+    }
+  }
+}
+
 bool Board::AddBoat(const ShipType& ship, const Location start_location,
                     const Orientation orientation) {
-  const std::vector<Location>& boat_target_locations = AllLocationsFor(ship, start_location,
+  if ((placed_boats.size() >= max_boats) ||
+      (!fleet_registry.Find(ship).has_value() &&
+       (fleet_registry.GetCount() >= FleetRegistry::max_ship_types))) {
+    return false;
+  }
+
+  const std::vector<Location>& boat_target_locations = AllLocationsFor(ship.size, start_location,
                                                                        orientation);
 
   for (const Location location : boat_target_locations) {
-    if (HasBoat(location) || !IsInRange(location)) {
+    if (!IsInRange(location) || HasBoat(location)) {
       return false;
     }
   }
 
-  for (const Location location : boat_target_locations) {
-    boats.emplace(location, Boat(ship, orientation));
-  }
+  const ShipTypeId ship_type_id = fleet_registry.Intern(ship);
 
-  boat_name_to_location.emplace(ship.name, start_location);
+  placed_boats.push_back(PlacedBoat{ ship_type_id, orientation, start_location, 0 });
+  PlaceBoatCells(placed_boats.size() - 1);
+
+  if (!IsSunk(placed_boats.back())) {
+    remaining_ship_ids.push_back(ship_type_id);
+  }
 
   return true;
 }
@@ -123,22 +114,58 @@ int Board::GetHeight() const {
 }
 
 std::optional<Boat> Board::GetBoat(const Location location) const {
-  auto search = boats.find(location);
+  if (!HasBoat(location)) {
+    return std::nullopt;
+  }
 
-  if (search != boats.end()) {
-    return search->second;
+  const PlacedBoat& placed_boat = placed_boats[boat_indices[CellIndex(location)] - 1];
+
+  return Boat(fleet_registry.GetShipType(placed_boat.ship_type_id), placed_boat.orientation);
+}
+
+std::optional<ShipTypeId> Board::GetShipTypeId(const Location location) const {
+  if (!HasBoat(location)) {
+    return std::nullopt;
   }
 
-  return std::nullopt;
+  return placed_boats[boat_indices[CellIndex(location)] - 1].ship_type_id;
+}
+
+const FleetRegistry& Board::GetFleetRegistry() const {
+  return fleet_registry;
 }
 
 int Board::PlacedBoatsCount() const {
-  return boat_name_to_location.size();
+  return placed_boats.size();
+}
+
+std::vector<ShipType> Board::GetPlacedShips() const {
+  std::vector<ShipType> placed_ships;
+  placed_ships.reserve(placed_boats.size());
+
+  for (const PlacedBoat& placed_boat : placed_boats) {
+    placed_ships.push_back(fleet_registry.GetShipType(placed_boat.ship_type_id));
+  }
+
+  return placed_ships;
+}
+
+std::vector<BoatPlacement> Board::GetBoatPlacements() const {
+  std::vector<BoatPlacement> boat_placements;
+  boat_placements.reserve(placed_boats.size());
+
+  for (const PlacedBoat& placed_boat : placed_boats) {
+    boat_placements.push_back(BoatPlacement{ fleet_registry.GetShipType(placed_boat.ship_type_id),
+                                             placed_boat.start_location,
+                                             placed_boat.orientation });
+  }
+
+  return boat_placements;
 }
 
 bool Board::MoveBoat(const ShipType& ship, const Location new_location,
                      const Orientation new_orientation) {
-  const std::vector<Location> all_new_locations = AllLocationsFor(ship, new_location,
+  const std::vector<Location> all_new_locations = AllLocationsFor(ship.size, new_location,
                                                                   new_orientation);
 
   for (const Location location : all_new_locations) {
@@ -147,61 +174,154 @@ bool Board::MoveBoat(const ShipType& ship, const Location new_location,
     }
   }
 
-  if (boat_name_to_location.find(ship.name) == boat_name_to_location.end()) {
+  const std::optional<ShipTypeId> ship_type_id = fleet_registry.Find(ship);
+  const int boat_index = ship_type_id.has_value() ? FindBoatIndex(*ship_type_id) : -1;
+
+  if (boat_index < 0) {
     return false;
   }
 
-  const Location& old_starting_location = boat_name_to_location.at(ship.name);
-  const Boat& boat = boats.at(old_starting_location);
+  ClearBoatCells(boat_index);
 
-  for (const Location location : AllLocationsFor(ship, old_starting_location,
-                                                 boat.GetOrientation())) {
-    boats.erase(location);
+  for (const Location location : all_new_locations) {
+    if (HasBoat(location)) {
+      PlaceBoatCells(boat_index);
+      return false;
+    }
   }
 
-  boat_name_to_location.erase(ship.name);
-
-  if (!AddBoat(ship, new_location, new_orientation)) {
-    AddBoat(ship, old_starting_location, boat.GetOrientation());
-    return false;
-  }
+  placed_boats[boat_index] = PlacedBoat{ *ship_type_id, new_orientation, new_location, 0 };
+  PlaceBoatCells(boat_index);
+  RebuildRemainingShips();
 
   return true;
 }
 
 
 bool Board::Shoot(const Location location) {
-  if (HasShot(location) || !IsInRange(location)) {
+  PROFILE_SCOPE(ProfilePoint::BoardShoot);
+  last_shot_cells.clear();
+
+  return FireAt(location);
+}
+
+std::vector<ShotOutcome> Board::ShootMany(const std::vector<Location>& locations) {
+  PROFILE_SCOPE(ProfilePoint::BoardShootMany);
+  last_shot_cells.clear();
+
+  std::vector<ShotOutcome> outcomes(locations.size(), ShotOutcome::Rejected);
+  const bool has_ships_afloat = !AreAllShipsSunk();
+
+  for (int shot = 0; shot < static_cast<int>(locations.size()); ++shot) {
+    if (has_ships_afloat && AreAllShipsSunk()) {
+      break;
+    }
+
+    const Location location = locations[shot];
+
+    if (!FireAt(location)) {
+      continue;
+    }
+
+    if (IsMine(location)) {
+      outcomes[shot] = ShotOutcome::Mine;
+    } else if (HasBoat(location)) {
+      const bool is_sunk = IsSunk(placed_boats[boat_indices[CellIndex(location)] - 1]);
+      outcomes[shot] = is_sunk ? ShotOutcome::Sunk : ShotOutcome::Hit;
+    } else {
+      outcomes[shot] = ShotOutcome::Miss;
+    }
+  }
+
+  return outcomes;
+}
+
+bool Board::FireAt(const Location location) {
+  if (!IsInRange(location) || HasShot(location)) {
     return false;
   }
 
-  shot_locations.emplace(location);
-
-  if (IsMine(location)) {
-    const Location above(location.x, location.y - 1);
-    const Location below(location.x, location.y + 1);
-    const Location left(location.x - 1, location.y);
-    const Location right(location.x +  1, location.y);
-    const Location above_left(location.x - 1, location.y - 1);
-    const Location above_right(location.x + 1, location.y - 1);
-    const Location below_left(location.x - 1, location.y + 1);
-    const Location below_right(location.x + 1, location.y + 1);
-
-    Shoot(above);
-    Shoot(below);
-    Shoot(left);
-    Shoot(right);
-    Shoot(above_left);
-    Shoot(above_right);
-    Shoot(below_left);
-    Shoot(below_right);
+  // Cells are shot in the same depth first order as a recursive chain reaction would, checking
+  // each one as it comes off the stack since an earlier branch may have reached it already.
+  pending_shots.clear();
+  pending_shots.push_back(location);
+
+  while (!pending_shots.empty()) {
+    const Location cell = pending_shots.back();
+    pending_shots.pop_back();
+
+    if (!IsInRange(cell) || shot_cells.Test(cell.x, cell.y)) {
+      continue;
+    }
+
+    shot_cells.Set(cell.x, cell.y);
+    RemoveNotFiredCell(CellIndex(cell));
+    RecordChange(cell);
+    last_shot_cells.push_back(cell);
+    shot_history.push_back(CellIndex(cell));
+
+    if (HasBoat(cell)) {
+      RecordHit(boat_indices[CellIndex(cell)] - 1);
+    }
+
+    if (IsMine(cell)) {
+      // Pushed in reverse so that above is shot first, then below, left, right and the corners.
+      pending_shots.emplace_back(cell.x + 1, cell.y + 1);
+      pending_shots.emplace_back(cell.x - 1, cell.y + 1);
+      pending_shots.emplace_back(cell.x + 1, cell.y - 1);
+      pending_shots.emplace_back(cell.x - 1, cell.y - 1);
+      pending_shots.emplace_back(cell.x + 1, cell.y);
+      pending_shots.emplace_back(cell.x - 1, cell.y);
+      pending_shots.emplace_back(cell.x, cell.y + 1);
+      pending_shots.emplace_back(cell.x, cell.y - 1);
+    }
   }
 
   return true;
 }
 
+BoardSnapshot Board::Snapshot() const {
+  return BoardSnapshot{ static_cast<int>(shot_history.size()),
+                        static_cast<int>(changed_cells.size()) };
+}
+
+void Board::Restore(const BoardSnapshot snapshot) {
+  bool has_refloated_ship = false;
+
+  while (static_cast<int>(shot_history.size()) > snapshot.shot_count) {
+    const int cell_index = shot_history.back();
+    const Location cell = CellLocation(cell_index);
+    shot_history.pop_back();
+
+    shot_cells.Clear(cell.x, cell.y);
+    AddNotFiredCell(cell_index);
+
+    if (HasBoat(cell)) {
+      PlacedBoat& placed_boat = placed_boats[boat_indices[cell_index] - 1];
+      has_refloated_ship |= IsSunk(placed_boat);
+      --placed_boat.hits;
+    }
+  }
+
+  if (has_refloated_ship) {
+    RebuildRemainingShips();
+  }
+
+  // Anything that followed the changes past the snapshot has to start over from the board.
+  if (static_cast<int>(changed_cells.size()) > snapshot.changed_cell_count) {
+    changed_cells.resize(snapshot.changed_cell_count);
+    ++reset_count;
+  }
+
+  last_shot_cells.clear();
+}
+
+const std::vector<Location>& Board::GetLastShotCells() const {
+  return last_shot_cells;
+}
+
 bool Board::HasShot(const Location location) const {
-  return shot_locations.find(location) != shot_locations.end();
+  return IsInRange(location) && shot_cells.Test(location.x, location.y);
 }
 
 bool Board::IsHit(const Location location) const {
@@ -213,30 +333,31 @@ bool Board::IsInRange(const Location location) const {
 }
 
 bool Board::AreAllShipsSunk() const {
-  return std::all_of(boats.begin(), boats.end(), [this](const auto& pair)
-  {
-    return IsHit(pair.first);
-  });
+  return remaining_ship_ids.empty();
 }
 
 bool Board::HasBoat(const Location location) const {
-  return boats.find(location) != boats.end();
+  return IsInRange(location) && boat_cells.Test(location.x, location.y);
 }
 
 void Board::Reset() {
-  boats.clear();
-  boat_name_to_location.clear();
+  placed_boats.clear();
+  remaining_ship_ids.clear();
+  changed_cells.clear();
+  ++reset_count;
+  boat_indices.fill(0);
+  boat_cells.Reset();
 }
 
 std::vector<Location> Board::NotFiredLocations() const {
+  PROFILE_SCOPE(ProfilePoint::BoardNotFiredLocations);
   std::vector<Location> locations;
+  locations.reserve(not_fired_cells.size());
 
   for (int x = 1; x <= width; ++x) {
     for (int y = 1; y <= height; ++y) {
-      Location location(x, y);
-
-      if (!HasShot(location)) {
-        locations.emplace_back(location);
+      if (!shot_cells.Test(x, y)) {
+        locations.emplace_back(x, y);
       }
     }
   }
@@ -244,43 +365,145 @@ std::vector<Location> Board::NotFiredLocations() const {
   return locations;
 }
 
-bool Board::HasBeenKilled(const ShipType& ship_type) const {
-  const Location initial_location = boat_name_to_location.at(ship_type.name);
-  const Orientation orientation = boats.at(initial_location).GetOrientation();
+int Board::NotFiredCount() const {
+  return not_fired_cells.size();
+}
+
+Location Board::NotFiredLocation(const int index) const {
+  const int cell_index = not_fired_cells.at(index);
+  return Location((cell_index % BitPlane::max_size) + 1, (cell_index / BitPlane::max_size) + 1);
+}
+
+void Board::RemoveNotFiredCell(const int cell_index) {
+  const int position = not_fired_positions[cell_index];
+  const int last_cell_index = not_fired_cells.back();
+
+  not_fired_cells[position] = last_cell_index;
+  not_fired_positions[last_cell_index] = position;
+  not_fired_cells.pop_back();
+}
+
+void Board::AddNotFiredCell(const int cell_index) {
+  not_fired_positions[cell_index] = not_fired_cells.size();
+  not_fired_cells.push_back(cell_index);
+}
+
+const std::vector<Location>& Board::GetChangedCells() const {
+  return changed_cells;
+}
+
+int Board::GetResetCount() const {
+  return reset_count;
+}
 
-  for (const Location location : AllLocationsFor(ship_type, initial_location, orientation)) {
-    if (!IsHit(location)) {
-      return  false;
+void Board::RecordChange(const Location location) {
+  changed_cells.push_back(location);
+}
+
+std::vector<ShipType> Board::GetRemainingShips() const {
+  PROFILE_SCOPE(ProfilePoint::BoardGetRemainingShips);
+  std::vector<ShipType> remaining_ships;
+  remaining_ships.reserve(remaining_ship_ids.size());
+
+  for (const ShipTypeId ship_type_id : remaining_ship_ids) {
+    remaining_ships.push_back(fleet_registry.GetShipType(ship_type_id));
+  }
+
+  return remaining_ships;
+}
+
+const std::vector<ShipTypeId>& Board::GetRemainingShipIds() const {
+  return remaining_ship_ids;
+}
+
+int Board::RemainingShipsCount() const {
+  return remaining_ship_ids.size();
+}
+
+bool Board::IsSunk(const PlacedBoat& placed_boat) const {
+  return placed_boat.hits >= fleet_registry.GetSize(placed_boat.ship_type_id);
+}
+
+void Board::RecordHit(const int boat_index) {
+  PlacedBoat& placed_boat = placed_boats[boat_index];
+  ++placed_boat.hits;
+
+  if (placed_boat.hits == fleet_registry.GetSize(placed_boat.ship_type_id)) {
+    const auto sunk_ship = std::find(remaining_ship_ids.begin(), remaining_ship_ids.end(),
+                                     placed_boat.ship_type_id);
+
+    if (sunk_ship != remaining_ship_ids.end()) {
+      remaining_ship_ids.erase(sunk_ship);
     }
   }
+}
 
-  return true;
+void Board::RebuildRemainingShips() {
+  remaining_ship_ids.clear();
+
+  for (const PlacedBoat& placed_boat : placed_boats) {
+    if (!IsSunk(placed_boat)) {
+      remaining_ship_ids.push_back(placed_boat.ship_type_id);
+    }
+  }
 }
 
-std::vector<ShipType> Board::GetRemainingShips() const {
-  std::set<ShipType> remaining_ships;
+int Board::CellIndex(const Location location) const {
+  return ((location.y - 1) * BitPlane::max_size) + (location.x - 1);
+}
 
-  for (const auto& pair : boats) {
-    remaining_ships.emplace(pair.second.GetShipType());
+Location Board::CellLocation(const int cell_index) const {
+  return Location((cell_index % BitPlane::max_size) + 1, (cell_index / BitPlane::max_size) + 1);
+}
+
+int Board::FindBoatIndex(const ShipTypeId ship_type_id) const {
+  for (int boat_index = 0; boat_index < static_cast<int>(placed_boats.size()); ++boat_index) {
+    if (placed_boats[boat_index].ship_type_id == ship_type_id) {
+      return boat_index;
+    }
   }
 
-  for (auto current = remaining_ships.begin(); current != remaining_ships.end(); ) {
-    if (HasBeenKilled(*current)) {
-      current = remaining_ships.erase(current);
-    } else {
-      ++current;
+  return -1;
+}
+
+void Board::PlaceBoatCells(const int boat_index) {
+  PlacedBoat& placed_boat = placed_boats[boat_index];
+  placed_boat.hits = 0;
+
+  for (const Location location : AllLocationsFor(fleet_registry.GetSize(placed_boat.ship_type_id),
+                                                 placed_boat.start_location,
+                                                 placed_boat.orientation)) {
+    if (shot_cells.Test(location.x, location.y)) {
+      ++placed_boat.hits;
     }
+
+    boat_cells.Set(location.x, location.y);
+    boat_indices[CellIndex(location)] = boat_index + 1;
+    RecordChange(location);
   }
+}
+
+void Board::ClearBoatCells(const int boat_index) {
+  const PlacedBoat& placed_boat = placed_boats[boat_index];
 
-  return std::vector<ShipType>(remaining_ships.begin(), remaining_ships.end());
+  for (const Location location : AllLocationsFor(fleet_registry.GetSize(placed_boat.ship_type_id),
+                                                 placed_boat.start_location,
+                                                 placed_boat.orientation)) {
+    boat_cells.Clear(location.x, location.y);
+    boat_indices[CellIndex(location)] = 0;
+    RecordChange(location);
+  }
 }
 
 void Board::AddMine(const Location location) {
-  mine_locations.emplace(location);
+  if (IsInRange(location)) {
+    mine_cells.Set(location.x, location.y);
+    RecordChange(location);
+  }
 }
 
 bool Board::IsMine(const Location location) const {
-  return mine_locations.find(location) != mine_locations.end();
+  return IsInRange(location) && mine_cells.Test(location.x, location.y);
 }
 
 void Board::AddRandomMines(PlacementGenerator& placement_generator) {
@@ -1,12 +1,15 @@
 #ifndef SRC_BOARD_BOARD_H
 #define SRC_BOARD_BOARD_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <optional>
-#include <set>
-#include <unordered_map>
 #include <vector>
 
+#include "bit-plane.h"
 #include "configuration/configuration.h"
+#include "fleet-registry.h"
 
 class LetterIndex {
 public:
@@ -68,14 +71,46 @@ private:
   Orientation orientation;
 };
 
+// Marks how far a board had been fired at, so that later shots can be taken back.
+struct BoardSnapshot {
+  int shot_count;
+  int changed_cell_count;
+};
+
+// What one location of a volley did. Mine wins over a boat under it, and Sunk is a hit that sank
+// its boat.
+enum class ShotOutcome : std::uint8_t {
+  // Off the board, already shot (even by an earlier chain reaction in the same volley), or after
+  // the last ship was sunk.
+  Rejected,
+  Miss,
+  Hit,
+  Sunk,
+  Mine
+};
+
+struct BoatPlacement {
+  ShipType ship_type;
+  Location start_location;
+  Orientation orientation;
+};
+
+// Cells are stored densely: one bit plane each for boats, shots and mines, plus a per-cell index
+// into the list of placed boats. Boards larger than BitPlane::max_size are clamped to it. Placed
+// boats and remaining ships refer to their types by id in the board's fleet registry, which starts
+// as a copy of the one given and takes in any other type a boat is added with.
 class Board {
 public:
-  Board(const int width, const int height)
-    : width(width), height(height) {}
+  Board(const int width, const int height);
+  Board(const int width, const int height, const FleetRegistry& fleet_registry);
 
   bool AddBoat(const ShipType& ship, const Location start_location, const Orientation orientation);
   bool MoveBoat(const ShipType& ship, const Location new_location, const Orientation new_orientation);
   bool Shoot(const Location location);
+  // Fires at every location in order as Shoot would, chain reactions included, and stops once
+  // the volley has sunk the last ship. Returns one outcome per location; GetLastShotCells then
+  // lists every cell the volley shot.
+  std::vector<ShotOutcome> ShootMany(const std::vector<Location>& locations);
   void Reset();
   void AddMine(const Location location);
   void AddRandomMines(class PlacementGenerator& placement_generator);
@@ -83,36 +118,94 @@ public:
   int GetWidth() const;
   int GetHeight() const;
   int PlacedBoatsCount() const;
+  // The types of all placed boats, sunk or not, in placement order.
+  std::vector<ShipType> GetPlacedShips() const;
+  // Where every placed boat lies, in placement order.
+  std::vector<BoatPlacement> GetBoatPlacements() const;
   std::optional<Boat> GetBoat(const Location location) const;
+  // The type of the boat at location without copying its name.
+  std::optional<ShipTypeId> GetShipTypeId(const Location location) const;
+  const FleetRegistry& GetFleetRegistry() const;
   bool HasShot(const Location location) const;
   bool IsHit(const Location location) const;
   bool AreAllShipsSunk() const;
   bool IsMine(const Location location) const;
   std::vector<Location> NotFiredLocations() const;
+  int NotFiredCount() const;
+  // Any index in [0, NotFiredCount()); the order changes as cells are shot.
+  Location NotFiredLocation(const int index) const;
+  // Cells newly shot by the last call to Shoot: the fired location first, followed by every cell a
+  // mine chain reaction reached. Empty if that shot was rejected.
+  const std::vector<Location>& GetLastShotCells() const;
+  // Ships not sunk yet, in placement order.
   std::vector<ShipType> GetRemainingShips() const;
+  const std::vector<ShipTypeId>& GetRemainingShipIds() const;
+  int RemainingShipsCount() const;
+
+  // Every cell whose boat, shot or mine changed since the board was created or last reset, in the
+  // order the changes happened. Cells can appear more than once. Restore takes back the changes
+  // made since its snapshot rather than adding more.
+  const std::vector<Location>& GetChangedCells() const;
+  // Incremented whenever changed cells are dropped: by Reset, which empties them, and by Restore.
+  int GetResetCount() const;
 
   bool IsWithinBounds(const Location location) const;
 
+  // Snapshots only cover shots, which makes taking one free and restoring one cost as much as the
+  // shots it takes back. Boats and mines changed since are left as they are.
+  BoardSnapshot Snapshot() const;
+  // Un-fires every cell shot after the snapshot was taken, latest first.
+  void Restore(const BoardSnapshot snapshot);
+
 private:
   bool IsInRange(const Location location) const;
+  // Shoot without clearing the last shot cells.
+  bool FireAt(const Location location);
   bool HasBoat(const Location location) const;
-  bool HasBeenKilled(const ShipType& ship_type) const;
-
-  class LocationHasher {
-  public:
-    std::size_t operator()(const Location location) const {
-      std::size_t xHash = std::hash<int>()(location.x);
-      std::size_t yHash = std::hash<int>()(location.y);
-      return xHash ^ (yHash << 1);
-    }
+  void RecordHit(const int boat_index);
+  void RebuildRemainingShips();
+  int CellIndex(const Location location) const;
+  Location CellLocation(const int cell_index) const;
+  int FindBoatIndex(const ShipTypeId ship_type_id) const;
+  void PlaceBoatCells(const int boat_index);
+  void ClearBoatCells(const int boat_index);
+  void RemoveNotFiredCell(const int cell_index);
+  void AddNotFiredCell(const int cell_index);
+  void RecordChange(const Location location);
+
+  struct PlacedBoat {
+    ShipTypeId ship_type_id;
+    Orientation orientation;
+    Location start_location;
+    int hits;
   };
 
+  bool IsSunk(const PlacedBoat& placed_boat) const;
+
+  // Cells with no boat hold 0, otherwise the position of the boat in placed_boats plus one.
+  static constexpr int max_boats = 255;
+
   int width;
   int height;
-  std::unordered_map<std::string, Location> boat_name_to_location;
-  std::unordered_map<Location, Boat, LocationHasher> boats;
-  std::set<Location> shot_locations;
-  std::set<Location> mine_locations;
+  FleetRegistry fleet_registry;
+  std::vector<PlacedBoat> placed_boats;
+  // Ships not sunk yet, in placement order, kept up to date by Shoot.
+  std::vector<ShipTypeId> remaining_ship_ids;
+  std::array<std::uint8_t, BitPlane::max_size * BitPlane::max_size> boat_indices{};
+  // Cell indices not shot yet, removed by swapping with the last entry, and each cell's position
+  // in that pool so that it can be found in constant time.
+  std::vector<std::uint16_t> not_fired_cells;
+  std::array<std::uint16_t, BitPlane::max_size * BitPlane::max_size> not_fired_positions{};
+  std::vector<Location> changed_cells;
+  std::vector<Location> last_shot_cells;
+  // Cell indices of every shot in the order they were fired, for Restore.
+  std::vector<std::uint16_t> shot_history;
+  // Worklist for mine chain reactions, kept to reuse its storage between shots.
+  std::vector<Location> pending_shots;
+  int reset_count = 0;
+  BitPlane boat_cells;
+  BitPlane shot_cells;
+  BitPlane mine_cells;
 };
 
 #endif // SRC_BOARD_BOARD_H
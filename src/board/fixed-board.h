@@ -0,0 +1,218 @@
+#ifndef SRC_BOARD_FIXED_BOARD_H
+#define SRC_BOARD_FIXED_BOARD_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+#include "board.h"
+
+// A board whose size is fixed at compile time, for simulation kernels that only shoot. Cells are
+// numbered row by row on a grid with a one cell border all round, so that every neighbour of a
+// cell is a valid index and the border, which starts out shot, needs no range checks: a shot or
+// a chain reaction reaching it is skipped just like one reaching a cell that was already shot.
+// Shots follow Board exactly, including the order of the not-fired pool and of mine chain
+// reactions, so a game played on either board with the same draws plays out the same.
+template<int Width, int Height>
+class FixedBoard {
+public:
+  static_assert((Width > 0) && (Height > 0) && (Width <= BitPlane::max_size) &&
+                (Height <= BitPlane::max_size));
+
+  static constexpr int stride = Width + 2;
+  static constexpr int cell_count = stride * (Height + 2);
+  static constexpr int max_placed_boats = 255;
+
+  // Takes the boats and mines of board, which must be Width x Height. The copy starts unshot.
+  explicit FixedBoard(const Board& board) {
+    for (int y = 0; y <= Height + 1; ++y) {
+      for (int x = 0; x <= Width + 1; ++x) {
+        if ((x == 0) || (y == 0) || (x > Width) || (y > Height)) {
+          shot_cells.set(Cell(x, y));
+        } else {
+          not_fired_positions[Cell(x, y)] = not_fired_count;
+          not_fired_cells[not_fired_count++] = Cell(x, y);
+
+          if (board.IsMine(Location(x, y))) {
+            mine_cells.set(Cell(x, y));
+          }
+        }
+      }
+    }
+
+    for (const BoatPlacement& boat_placement : board.GetBoatPlacements()) {
+      const int boat_number = ++placed_boats_count;
+      const int step = boat_placement.orientation == Orientation::Vertical ? stride : 1;
+      int cell = Cell(boat_placement.start_location.x, boat_placement.start_location.y);
+
+      boat_sizes[boat_number] = boat_placement.ship_type.size;
+
+      for (int part = 0; part < boat_placement.ship_type.size; ++part, cell += step) {
+        boat_numbers[cell] = boat_number;
+      }
+    }
+
+    remaining_ships_count = placed_boats_count;
+  }
+
+  static constexpr int GetWidth() {
+    return Width;
+  }
+
+  static constexpr int GetHeight() {
+    return Height;
+  }
+
+  static constexpr int Cell(const int x, const int y) {
+    return (y * stride) + x;
+  }
+
+  static constexpr Location CellLocation(const int cell) {
+    return Location(cell % stride, cell / stride);
+  }
+
+  bool Shoot(const Location location) {
+    last_shot_count = 0;
+
+    return IsWithinBounds(location) && FireAt(Cell(location.x, location.y));
+  }
+
+  // Board::ShootMany over count cells, writing one outcome per cell.
+  void ShootMany(const int* const cells, const int count, ShotOutcome* const outcomes) {
+    last_shot_count = 0;
+    const bool has_ships_afloat = !AreAllShipsSunk();
+
+    for (int shot = 0; shot < count; ++shot) {
+      const int cell = cells[shot];
+
+      if ((has_ships_afloat && AreAllShipsSunk()) || !FireAt(cell)) {
+        outcomes[shot] = ShotOutcome::Rejected;
+      } else if (mine_cells.test(cell)) {
+        outcomes[shot] = ShotOutcome::Mine;
+      } else if (boat_numbers[cell] != 0) {
+        const int boat_number = boat_numbers[cell];
+        const bool is_sunk = boat_hits[boat_number] == boat_sizes[boat_number];
+        outcomes[shot] = is_sunk ? ShotOutcome::Sunk : ShotOutcome::Hit;
+      } else {
+        outcomes[shot] = ShotOutcome::Miss;
+      }
+    }
+  }
+
+  bool IsWithinBounds(const Location location) const {
+    return (location.x > 0) && (location.y > 0) && (location.x <= Width) &&
+           (location.y <= Height);
+  }
+
+  // Border cells count as shot.
+  bool IsCellShot(const int cell) const {
+    return shot_cells.test(cell);
+  }
+
+  bool IsCellHit(const int cell) const {
+    return (boat_numbers[cell] != 0) && shot_cells.test(cell);
+  }
+
+  bool IsCellMine(const int cell) const {
+    return mine_cells.test(cell);
+  }
+
+  bool AreAllShipsSunk() const {
+    return remaining_ships_count == 0;
+  }
+
+  int RemainingShipsCount() const {
+    return remaining_ships_count;
+  }
+
+  int NotFiredCount() const {
+    return not_fired_count;
+  }
+
+  // Any index in [0, NotFiredCount()), in the same order as Board::NotFiredLocation.
+  int NotFiredCell(const int index) const {
+    return not_fired_cells[index];
+  }
+
+  // The cells newly shot by the last call to Shoot, as Board::GetLastShotCells.
+  int LastShotCount() const {
+    return last_shot_count;
+  }
+
+  int LastShotCell(const int index) const {
+    return last_shot_cells[index];
+  }
+
+private:
+  // Shoot without clearing the last shot cells. The border counts as shot, so it is rejected.
+  bool FireAt(const int fire_cell) {
+    if (shot_cells.test(fire_cell)) {
+      return false;
+    }
+
+    int pending_count = 0;
+    pending_shots[pending_count++] = fire_cell;
+
+    while (pending_count > 0) {
+      const int cell = pending_shots[--pending_count];
+
+      if (shot_cells.test(cell)) {
+        continue;
+      }
+
+      shot_cells.set(cell);
+      RemoveNotFiredCell(cell);
+      last_shot_cells[last_shot_count++] = cell;
+
+      if (boat_numbers[cell] != 0) {
+        RecordHit(boat_numbers[cell]);
+      }
+
+      if (mine_cells.test(cell)) {
+        for (const int offset : chain_reaction_offsets) {
+          pending_shots[pending_count++] = cell + offset;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // Pushed in this order and popped in reverse, matching Board's chain reactions.
+  static constexpr std::array<int, 8> chain_reaction_offsets = {
+    stride + 1, stride - 1, 1 - stride, -1 - stride, 1, -1, stride, -stride
+  };
+
+  void RecordHit(const int boat_number) {
+    if (++boat_hits[boat_number] == boat_sizes[boat_number]) {
+      --remaining_ships_count;
+    }
+  }
+
+  void RemoveNotFiredCell(const int cell) {
+    const int position = not_fired_positions[cell];
+    const int last_cell = not_fired_cells[--not_fired_count];
+
+    not_fired_cells[position] = last_cell;
+    not_fired_positions[last_cell] = position;
+  }
+
+  std::bitset<cell_count> shot_cells;
+  std::bitset<cell_count> mine_cells;
+  // Cells with no boat hold 0, otherwise the boat's number counting from 1.
+  std::array<std::uint8_t, cell_count> boat_numbers{};
+  std::array<int, max_placed_boats + 1> boat_sizes{};
+  std::array<int, max_placed_boats + 1> boat_hits{};
+  int placed_boats_count = 0;
+  int remaining_ships_count = 0;
+  std::array<std::uint16_t, Width * Height> not_fired_cells{};
+  std::array<std::uint16_t, cell_count> not_fired_positions{};
+  int not_fired_count = 0;
+  std::array<std::uint16_t, Width * Height> last_shot_cells{};
+  int last_shot_count = 0;
+  // Every cell is shot at most once and only a mine pushes its neighbours, so at most eight per
+  // cell can be waiting.
+  std::array<std::uint16_t, (8 * Width * Height) + 1> pending_shots{};
+};
+
+#endif // SRC_BOARD_FIXED_BOARD_H
@@ -0,0 +1,35 @@
+#include "fleet-registry.h"
+
+#include <algorithm>
+
+FleetRegistry::FleetRegistry(const std::vector<ShipType>& ship_types) {
+  for (const ShipType& ship_type : ship_types) {
+    Intern(ship_type);
+  }
+}
+
+ShipTypeId FleetRegistry::Intern(const ShipType& ship_type) {
+  const std::optional<ShipTypeId> ship_type_id = Find(ship_type);
+
+  if (ship_type_id.has_value()) {
+    return *ship_type_id;
+  }
+
+  ship_types.push_back(ship_type);
+
+  return ship_types.size() - 1;
+}
+
+std::optional<ShipTypeId> FleetRegistry::Find(const ShipType& ship_type) const {
+  const auto found = std::find(ship_types.begin(), ship_types.end(), ship_type);
+
+  if (found == ship_types.end()) {
+    return std::nullopt;
+  }
+
+  return found - ship_types.begin();
+}
+
+int FleetRegistry::GetCount() const {
+  return ship_types.size();
+}
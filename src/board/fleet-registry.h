@@ -0,0 +1,48 @@
+#ifndef SRC_BOARD_FLEET_REGISTRY_H
+#define SRC_BOARD_FLEET_REGISTRY_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "configuration/configuration.h"
+
+// Small integer standing for a ship type, only meaningful to the registry that handed it out.
+using ShipTypeId = std::uint8_t;
+
+// Holds each ship type once and numbers them in the order they were added, so that boards can
+// store and compare ship types as ids and only look up names to display them. A registry built
+// from a configuration's ship types gives every type the id of its position in that list.
+class FleetRegistry {
+public:
+  // ShipTypeId has room for this many types.
+  static constexpr int max_ship_types = 256;
+
+  FleetRegistry() = default;
+  explicit FleetRegistry(const std::vector<ShipType>& ship_types);
+
+  // The id of a type with the same name and size, adding ship_type if there isn't one.
+  ShipTypeId Intern(const ShipType& ship_type);
+  // The id of ship_type if it has been added.
+  std::optional<ShipTypeId> Find(const ShipType& ship_type) const;
+
+  const ShipType& GetShipType(const ShipTypeId ship_type_id) const {
+    return ship_types[ship_type_id];
+  }
+
+  const std::string& GetName(const ShipTypeId ship_type_id) const {
+    return ship_types[ship_type_id].name;
+  }
+
+  int GetSize(const ShipTypeId ship_type_id) const {
+    return ship_types[ship_type_id].size;
+  }
+
+  int GetCount() const;
+
+private:
+  std::vector<ShipType> ship_types;
+};
+
+#endif // SRC_BOARD_FLEET_REGISTRY_H
@@ -0,0 +1,48 @@
+#include "philox-engine.h"
+
+constexpr std::uint32_t philox_multiplier_0 = 0xD2511F53;
+constexpr std::uint32_t philox_multiplier_1 = 0xCD9E8D57;
+constexpr std::uint32_t philox_weyl_0 = 0x9E3779B9;
+constexpr std::uint32_t philox_weyl_1 = 0xBB67AE85;
+constexpr int philox_rounds = 10;
+
+PhiloxEngine::PhiloxEngine(const std::uint64_t seed, const std::uint64_t stream) {
+  Seed(seed, stream);
+}
+
+void PhiloxEngine::Seed(const std::uint64_t seed, const std::uint64_t stream) {
+  key = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+  this->stream = stream;
+  next_index = 0;
+  loaded_block_index = std::numeric_limits<std::uint64_t>::max();
+}
+
+void PhiloxEngine::Discard(const std::uint64_t count) {
+  next_index += count;
+}
+
+PhiloxEngine::Counter PhiloxEngine::GenerateBlock(Counter counter, Key key) {
+  for (int round = 0; round < philox_rounds; ++round) {
+    const std::uint64_t product_0 = static_cast<std::uint64_t>(philox_multiplier_0) * counter[0];
+    const std::uint64_t product_1 = static_cast<std::uint64_t>(philox_multiplier_1) * counter[2];
+
+    counter = { static_cast<std::uint32_t>(product_1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product_1),
+                static_cast<std::uint32_t>(product_0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product_0) };
+
+    key[0] += philox_weyl_0;
+    key[1] += philox_weyl_1;
+  }
+
+  return counter;
+}
+
+void PhiloxEngine::LoadBlock(const std::uint64_t block_index) {
+  block = GenerateBlock({ static_cast<std::uint32_t>(block_index),
+                          static_cast<std::uint32_t>(block_index >> 32),
+                          static_cast<std::uint32_t>(stream),
+                          static_cast<std::uint32_t>(stream >> 32) },
+                        key);
+  loaded_block_index = block_index;
+}
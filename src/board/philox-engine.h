@@ -0,0 +1,58 @@
+#ifndef SRC_BOARD_PHILOX_ENGINE_H
+#define SRC_BOARD_PHILOX_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Philox4x32-10, the counter-based generator from Salmon et al., "Parallel Random Numbers: As Easy
+// as 1, 2, 3". Each block of four numbers is ten rounds of a keyed bijection applied to a 128-bit
+// counter, so the generator's state is just the key, taken from the seed, and a position. The upper
+// half of the counter holds a stream number, which gives every seed 2^64 independent streams of
+// 2^66 numbers each, and skipping ahead is a matter of moving the position. Only fixed-width
+// integer arithmetic is involved, so the numbers are the same on every platform.
+class PhiloxEngine {
+public:
+  using result_type = std::uint32_t;
+  using Counter = std::array<std::uint32_t, 4>;
+  using Key = std::array<std::uint32_t, 2>;
+
+  static constexpr result_type min() {
+    return 0;
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  explicit PhiloxEngine(const std::uint64_t seed = 0, const std::uint64_t stream = 0);
+
+  // Starts stream from its beginning.
+  void Seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+  // Skips ahead as if count numbers had been drawn, in constant time.
+  void Discard(const std::uint64_t count);
+
+  result_type operator()() {
+    const std::uint64_t block_index = next_index >> 2;
+
+    if (block_index != loaded_block_index) {
+      LoadBlock(block_index);
+    }
+
+    return block[next_index++ & 3];
+  }
+
+  static Counter GenerateBlock(Counter counter, Key key);
+
+private:
+  void LoadBlock(const std::uint64_t block_index);
+
+  Key key{};
+  std::uint64_t stream = 0;
+  // Counts numbers drawn from the stream so far, four to a block.
+  std::uint64_t next_index = 0;
+  std::uint64_t loaded_block_index = std::numeric_limits<std::uint64_t>::max();
+  Counter block{};
+};
+
+#endif // SRC_BOARD_PHILOX_ENGINE_H
@@ -11,6 +11,16 @@ public:
   virtual Location ChooseLocation(const std::vector<Location>& choices) {
     return Location();
   }
+
+  // Picks a location the board hasn't been shot at yet. Only call this while one is left.
+  virtual Location ChooseNotFiredLocation(const Board& board) {
+    return ChooseLocation(board.NotFiredLocations());
+  }
+
+  // Picks an index in [0, count).
+  virtual int ChooseIndex(const int /*count*/) {
+    return 0;
+  }
 };
 
 #endif // SRC_BOARD_PLACEMENT_GENERATOR_H
@@ -1,6 +1,40 @@
 #include "random-placement-generator.h"
 
-RandomPlacementGenerator::RandomPlacementGenerator() : random(std::random_device()()) {}
+std::uint64_t MixSeed(const std::uint64_t seed, const std::uint64_t index) {
+  std::uint64_t value = seed + ((index + 1) * 0x9E3779B97F4A7C15ULL);
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+RandomPlacementGenerator::RandomPlacementGenerator()
+  : engine(RandomEngine::MersenneTwister), mersenne_twister(std::random_device()()) {}
+
+RandomPlacementGenerator::RandomPlacementGenerator(const std::uint64_t seed,
+                                                   const RandomEngine engine)
+  : engine(engine) {
+  Seed(seed);
+}
+
+void RandomPlacementGenerator::Seed(const std::uint64_t seed, const std::uint64_t stream) {
+  if (engine == RandomEngine::Philox) {
+    philox.Seed(seed, stream);
+  } else {
+    mersenne_twister.seed((stream == 0) ? seed : MixSeed(seed, stream));
+  }
+}
+
+void RandomPlacementGenerator::Discard(const std::uint64_t count) {
+  if (engine == RandomEngine::Philox) {
+    philox.Discard(count);
+  } else {
+    mersenne_twister.discard(count);
+  }
+}
+
+RandomEngine RandomPlacementGenerator::GetEngine() const {
+  return engine;
+}
 
 Orientation RandomPlacementGenerator::GenerateOrientation() {
   if (RandomNumber(0, 1) == 0) {
@@ -11,14 +45,46 @@ Orientation RandomPlacementGenerator::GenerateOrientation() {
 }
 
 Location RandomPlacementGenerator::GenerateLocation(const int width, const int height) {
-  return Location(RandomNumber(1, width), RandomNumber(1, height));
+  const int x = RandomNumber(1, width);
+  const int y = RandomNumber(1, height);
+
+  return Location(x, y);
 }
 
 Location RandomPlacementGenerator::ChooseLocation(const std::vector<Location>& choices) {
   return choices.at(RandomNumber(0, choices.size() - 1));
 }
 
+Location RandomPlacementGenerator::ChooseNotFiredLocation(const Board& board) {
+  return board.NotFiredLocation(RandomNumber(0, board.NotFiredCount() - 1));
+}
+
+int RandomPlacementGenerator::ChooseIndex(const int count) {
+  return RandomNumber(0, count - 1);
+}
+
+// The Mersenne Twister's numbers are 64 bits wide, of which the upper half is used.
+std::uint32_t RandomPlacementGenerator::NextBits() {
+  if (engine == RandomEngine::Philox) {
+    return philox();
+  }
+
+  return static_cast<std::uint32_t>(mersenne_twister() >> 32);
+}
+
+// Lemire's multiply-and-shift: the upper half of a 32-bit number times the range, redrawing the
+// few numbers that would make some results more likely than others.
 int RandomPlacementGenerator::RandomNumber(const int start, const int end) {
-  std::uniform_int_distribution<int> distribution(start, end);
-  return distribution(random);
+  const std::uint32_t range = static_cast<std::uint32_t>(end - start) + 1;
+  std::uint64_t product = static_cast<std::uint64_t>(NextBits()) * range;
+
+  if (static_cast<std::uint32_t>(product) < range) {
+    const std::uint32_t threshold = (0u - range) % range;
+
+    while (static_cast<std::uint32_t>(product) < threshold) {
+      product = static_cast<std::uint64_t>(NextBits()) * range;
+    }
+  }
+
+  return start + static_cast<int>(product >> 32);
 }
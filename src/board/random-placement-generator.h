@@ -1,22 +1,53 @@
 #ifndef SRC_BOARD_RANDOM_PLACEMENT_GENERATOR_H
 #define SRC_BOARD_RANDOM_PLACEMENT_GENERATOR_H
 
+#include <cstdint>
 #include <random>
 
+#include "philox-engine.h"
 #include "placement-generator.h"
 
+enum class RandomEngine {
+  MersenneTwister,
+  // Counter based: streams are independent and skipping ahead takes constant time.
+  Philox
+};
+
+// SplitMix64 finaliser over a seed and an index, turning one master seed into well mixed,
+// independent seeds for numbered games, chunks or sessions.
+std::uint64_t MixSeed(const std::uint64_t seed, const std::uint64_t index);
+
+// Draws every number from the engine's raw output with a fixed rule instead of going through the
+// standard library's distributions, whose results differ between implementations, so the same
+// seed, engine and calls give the same placements and shots on every platform.
 class RandomPlacementGenerator : public PlacementGenerator {
 public:
+  // Seeds a Mersenne Twister from std::random_device.
   RandomPlacementGenerator();
+  explicit RandomPlacementGenerator(const std::uint64_t seed,
+                                    const RandomEngine engine = RandomEngine::MersenneTwister);
+
+  // Restarts the generator on one of the seed's streams. Philox streams are independent counter
+  // ranges, while the Mersenne Twister is seeded from the seed and stream mixed together.
+  void Seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+  // Skips ahead as if count numbers had been drawn. Constant time with Philox, linear with the
+  // Mersenne Twister.
+  void Discard(const std::uint64_t count);
+  RandomEngine GetEngine() const;
 
   Orientation GenerateOrientation() override;
   Location GenerateLocation(const int width, const int height) override;
   Location ChooseLocation(const std::vector<Location>& choices) override;
+  Location ChooseNotFiredLocation(const Board& board) override;
+  int ChooseIndex(const int count) override;
 
 private:
+  std::uint32_t NextBits();
   int RandomNumber(const int start, const int end);
 
-  std::mt19937_64 random;
+  RandomEngine engine;
+  std::mt19937_64 mersenne_twister;
+  PhiloxEngine philox;
 };
 
 #endif // SRC_BOARD_RANDOM_PLACEMENT_GENERATOR_H
@@ -0,0 +1,236 @@
+#include "window-counts.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ADASHIP_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+static_assert(BitPlane::words_per_row == 2, "lines are handled as a low and a high word");
+
+// For each cell along a line, the bits of the window starts whose windows cover it.
+struct CoveringStarts {
+  std::array<std::uint64_t, BitPlane::max_size> low;
+  std::array<std::uint64_t, BitPlane::max_size> high;
+};
+
+// The bits of the given word of a line that fall between cells first and last, counting from 0.
+std::uint64_t WordRangeMask(const int first, const int last, const int word) {
+  const int low_bit = std::max(first - (word * 64), 0);
+  const int high_bit = std::min(last - (word * 64), 63);
+
+  if (low_bit > high_bit) {
+    return 0;
+  }
+
+  return (~std::uint64_t(0) >> (63 - high_bit)) & (~std::uint64_t(0) << low_bit);
+}
+
+CoveringStarts FindCoveringStarts(const int line_length, const int length) {
+  CoveringStarts covering{};
+
+  for (int cell = 0; cell < line_length; ++cell) {
+    const int first_start = std::max(cell - length + 1, 0);
+    covering.low[cell] = WordRangeMask(first_start, cell, 0);
+    covering.high[cell] = WordRangeMask(first_start, cell, 1);
+  }
+
+  return covering;
+}
+
+int CountBits(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(bits);
+#else
+  bits -= (bits >> 1) & 0x5555555555555555;
+  bits = (bits & 0x3333333333333333) + ((bits >> 2) & 0x3333333333333333);
+  bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0f;
+  return static_cast<int>((bits * 0x0101010101010101) >> 56);
+#endif
+}
+
+// Counts along line_count lines of line_length cells, which are the rows of blocked, adding the
+// count for cell c of line l to counts[(l * line_step) + (c * cell_step)].
+void AddLineWindowCountsScalar(const BitPlane& blocked,
+                               const int line_length,
+                               const int line_count,
+                               const int length,
+                               int* const counts,
+                               const int line_step,
+                               const int cell_step) {
+  const CoveringStarts covering = FindCoveringStarts(line_length, length);
+  const std::uint64_t low_valid = WordRangeMask(0, line_length - 1, 0);
+  const std::uint64_t high_valid = WordRangeMask(0, line_length - 1, 1);
+
+  for (int line = 0; line < line_count; ++line) {
+    // A window can start on a cell when it and the length - 1 cells after it are open.
+    std::uint64_t shifted_low = ~blocked.Word(line + 1, 0) & low_valid;
+    std::uint64_t shifted_high = ~blocked.Word(line + 1, 1) & high_valid;
+    std::uint64_t start_low = shifted_low;
+    std::uint64_t start_high = shifted_high;
+
+    for (int offset = 1; offset < length; ++offset) {
+      shifted_low = (shifted_low >> 1) | (shifted_high << 63);
+      shifted_high >>= 1;
+      start_low &= shifted_low;
+      start_high &= shifted_high;
+    }
+
+    for (int cell = 0; cell < line_length; ++cell) {
+      counts[(line * line_step) + (cell * cell_step)] +=
+          CountBits(start_low & covering.low[cell]) + CountBits(start_high & covering.high[cell]);
+    }
+  }
+}
+
+#ifdef ADASHIP_AVX2_KERNEL
+// The number of set bits in each byte, looked up a nibble at a time.
+__attribute__((target("avx2"))) __m256i CountByteBitsAvx2(const __m256i bytes) {
+  const __m256i nibble_bits = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+
+  return _mm256_add_epi8(
+      _mm256_shuffle_epi8(nibble_bits, _mm256_and_si256(bytes, low_nibbles)),
+      _mm256_shuffle_epi8(nibble_bits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibbles)));
+}
+
+// AddLineWindowCountsScalar with four lines in the 64-bit lanes of each register.
+__attribute__((target("avx2"))) void AddLineWindowCountsAvx2(const BitPlane& blocked,
+                                                             const int line_length,
+                                                             const int line_count,
+                                                             const int length,
+                                                             int* const counts,
+                                                             const int line_step,
+                                                             const int cell_step) {
+  const CoveringStarts covering = FindCoveringStarts(line_length, length);
+  const __m256i low_valid = _mm256_set1_epi64x(WordRangeMask(0, line_length - 1, 0));
+  const __m256i high_valid = _mm256_set1_epi64x(WordRangeMask(0, line_length - 1, 1));
+  alignas(32) std::uint64_t lane_counts[4];
+
+  for (int first_line = 0; first_line < line_count; first_line += 4) {
+    const int lanes = std::min(line_count - first_line, 4);
+    // Lanes past the last line stay all blocked and so never hold a window.
+    alignas(32) std::uint64_t open_low[4] = {};
+    alignas(32) std::uint64_t open_high[4] = {};
+
+    for (int lane = 0; lane < lanes; ++lane) {
+      open_low[lane] = ~blocked.Word(first_line + lane + 1, 0);
+      open_high[lane] = ~blocked.Word(first_line + lane + 1, 1);
+    }
+
+    __m256i shifted_low =
+        _mm256_and_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(open_low)), low_valid);
+    __m256i shifted_high = _mm256_and_si256(
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(open_high)), high_valid);
+    __m256i start_low = shifted_low;
+    __m256i start_high = shifted_high;
+
+    for (int offset = 1; offset < length; ++offset) {
+      shifted_low = _mm256_or_si256(_mm256_srli_epi64(shifted_low, 1),
+                                    _mm256_slli_epi64(shifted_high, 63));
+      shifted_high = _mm256_srli_epi64(shifted_high, 1);
+      start_low = _mm256_and_si256(start_low, shifted_low);
+      start_high = _mm256_and_si256(start_high, shifted_high);
+    }
+
+    for (int cell = 0; cell < line_length; ++cell) {
+      const __m256i covered_low =
+          _mm256_and_si256(start_low, _mm256_set1_epi64x(covering.low[cell]));
+      const __m256i covered_high =
+          _mm256_and_si256(start_high, _mm256_set1_epi64x(covering.high[cell]));
+      // At most 16 bits per byte pair, so the bytes can't overflow before being summed per lane.
+      const __m256i byte_bits =
+          _mm256_add_epi8(CountByteBitsAvx2(covered_low), CountByteBitsAvx2(covered_high));
+
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane_counts),
+                         _mm256_sad_epu8(byte_bits, _mm256_setzero_si256()));
+
+      for (int lane = 0; lane < lanes; ++lane) {
+        counts[((first_line + lane) * line_step) + (cell * cell_step)] +=
+            static_cast<int>(lane_counts[lane]);
+      }
+    }
+  }
+}
+#endif
+
+void AddLineWindowCounts(const WindowCountKernel kernel,
+                         const BitPlane& blocked,
+                         const int line_length,
+                         const int line_count,
+                         const int length,
+                         int* const counts,
+                         const int line_step,
+                         const int cell_step) {
+#ifdef ADASHIP_AVX2_KERNEL
+  if (kernel == WindowCountKernel::Avx2) {
+    AddLineWindowCountsAvx2(blocked, line_length, line_count, length, counts, line_step,
+                            cell_step);
+    return;
+  }
+#endif
+
+  AddLineWindowCountsScalar(blocked, line_length, line_count, length, counts, line_step,
+                            cell_step);
+}
+
+WindowCountKernel BestWindowCountKernel() {
+  static const WindowCountKernel best_kernel =
+      IsWindowCountKernelSupported(WindowCountKernel::Avx2) ? WindowCountKernel::Avx2
+                                                            : WindowCountKernel::Scalar;
+  return best_kernel;
+}
+
+bool IsWindowCountKernelSupported(const WindowCountKernel kernel) {
+  switch (kernel) {
+    case WindowCountKernel::Scalar:
+      return true;
+    case WindowCountKernel::Avx2:
+#ifdef ADASHIP_AVX2_KERNEL
+      return __builtin_cpu_supports("avx2");
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+BitPlane TransposeBitPlane(const BitPlane& plane, const int width, const int height) {
+  BitPlane transposed;
+
+  for (int y = 1; y <= height; ++y) {
+    for (int x = 1; x <= width; ++x) {
+      if (plane.Test(x, y)) {
+        transposed.Set(y, x);
+      }
+    }
+  }
+
+  return transposed;
+}
+
+void CountOpenWindows(const BitPlane& blocked_rows,
+                      const BitPlane& blocked_columns,
+                      const int width,
+                      const int height,
+                      const int length,
+                      std::vector<int>& counts,
+                      const WindowCountKernel kernel) {
+  counts.assign(width * height, 0);
+
+  if ((length < 1) || (length > std::max(width, height))) {
+    return;
+  }
+
+  AddLineWindowCounts(kernel, blocked_rows, width, height, length, counts.data(), width, 1);
+
+  // A single cell window has one position per cell, not one per orientation.
+  if (length > 1) {
+    AddLineWindowCounts(kernel, blocked_columns, height, width, length, counts.data(), 1, width);
+  }
+}
@@ -0,0 +1,34 @@
+#ifndef SRC_BOARD_WINDOW_COUNTS_H
+#define SRC_BOARD_WINDOW_COUNTS_H
+
+#include <vector>
+
+#include "bit-plane.h"
+
+enum class WindowCountKernel {
+  Scalar,
+  // Four lines at a time in 256-bit registers, on x86 processors that support AVX2.
+  Avx2
+};
+
+// The fastest kernel the processor running the program supports, checked once.
+WindowCountKernel BestWindowCountKernel();
+bool IsWindowCountKernelSupported(const WindowCountKernel kernel);
+
+// The columns of a width x height plane as the rows of another, so that column x is row x.
+BitPlane TransposeBitPlane(const BitPlane& plane, const int width, const int height);
+
+// Sets counts to the number of windows of length cells holding no blocked cell that cover each
+// cell of a width x height board, horizontally and, for lengths above 1, vertically. Windows are
+// found a whole row of bits at a time with shifts and counted with popcounts, so the work per cell
+// doesn't grow with length. blocked_columns is TransposeBitPlane of blocked_rows and counts holds
+// the cells row by row. The kernel must be supported.
+void CountOpenWindows(const BitPlane& blocked_rows,
+                      const BitPlane& blocked_columns,
+                      const int width,
+                      const int height,
+                      const int length,
+                      std::vector<int>& counts,
+                      const WindowCountKernel kernel = BestWindowCountKernel());
+
+#endif // SRC_BOARD_WINDOW_COUNTS_H
@@ -1,79 +1,168 @@
 #include "computer-ai.h"
 
-std::vector<Location> All8LocationsAround(const Location location) {
-  std::vector<Location> locations;
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
 
+#include "profiling/profiler.h"
+
+std::array<Location, 4> All4LocationsAround(const Location location) {
   const Location top(location.x, location.y - 1);
   const Location bottom(location.x, location.y + 1);
   const Location left(location.x - 1, location.y);
   const Location right(location.x + 1, location.y);
-  const Location top_left(location.x - 1, location.y - 1);
-  const Location top_right(location.x + 1, location.y - 1);
-  const Location bottom_left(location.x - 1, location.y + 1);
-  const Location bottom_right(location.x + 1, location.y + 1);
-
-  locations.push_back(top);
-  locations.push_back(bottom);
-  locations.push_back(left);
-  locations.push_back(right);
-  locations.push_back(top_left);
-  locations.push_back(top_right);
-  locations.push_back(bottom_left);
-  locations.push_back(bottom_right);
 
-  return locations;
+  return { top, bottom, left, right };
 }
 
-std::vector<Location> All4LocationsAround(const Location location) {
-  std::vector<Location> locations;
-
-  const Location top(location.x, location.y - 1);
-  const Location bottom(location.x, location.y + 1);
-  const Location left(location.x - 1, location.y);
-  const Location right(location.x + 1, location.y);
+bool ComputerAi::IsValidLocation(const Location location) const {
+  return board.IsWithinBounds(location) && !board.HasShot(location);
+}
 
-  locations.push_back(top);
-  locations.push_back(bottom);
-  locations.push_back(left);
-  locations.push_back(right);
+bool ComputerAi::IsPlanned(const Location location) const {
+  return planned_shots.Test(location.x, location.y);
+}
 
-  return locations;
+void ComputerAi::SetTargetingMode(const TargetingMode targeting_mode) {
+  this->targeting_mode = targeting_mode;
+  heatmap.reset();
+  fleet_sampler.reset();
+  unresolved_hits.clear();
+  unresolved_hit_cells.Reset();
+  remaining_ship_sizes.reset();
 }
 
-bool ComputerAi::IsValidLocation(const Location location) const {
-  return board.IsWithinBounds(location) && !board.HasShot(location);
+void ComputerAi::SetMoveTimeBudget(const std::chrono::microseconds move_time_budget) {
+  this->move_time_budget = move_time_budget;
 }
 
-bool ComputerAi::AlreadyTargetedLocation(const Location location) const {
-  return already_targeted_locations.find(location) != already_targeted_locations.end();
+void ComputerAi::SetMoveAttemptBudget(const int move_attempt_budget) {
+  this->move_attempt_budget = move_attempt_budget;
 }
 
 Location ComputerAi::ChooseNextShot() {
-  TargetAllLocationsAroundShotIfHit(last_shot);
+  PROFILE_SCOPE(ProfilePoint::ComputerAiChooseNextShot);
+  const std::vector<Location>& shot_cells = board.GetLastShotCells();
+  const bool is_last_shot_on_board = !shot_cells.empty() && (shot_cells.front() == last_shot);
 
-  Location target;
+  // The board lists the whole mine chain reaction of the last shot, unless it has been fired at
+  // by someone else since, in which case only the last shot itself is looked at again.
+  if (targeting_mode == TargetingMode::Parity) {
+    if (!remaining_ship_sizes.has_value()) {
+      remaining_ship_sizes = RemainingShipSizes();
+    }
 
-  while (true) {
-    target = ChooseTarget();
+    if (is_last_shot_on_board) {
+      RecordParityShots(shot_cells);
+    } else if (board.HasShot(last_shot)) {
+      RecordParityShots({ last_shot });
+    }
+  } else if (is_last_shot_on_board) {
+    TargetLocationsAroundHits(shot_cells);
+  } else if (board.HasShot(last_shot)) {
+    TargetLocationsAroundHits({ last_shot });
+  }
+
+  if (targeting_mode == TargetingMode::ProbabilityDensity) {
+    // Built on first use so that it sees the opponent's fleet once it has been placed.
+    if (heatmap.has_value()) {
+      if (is_last_shot_on_board) {
+        heatmap->RecordShots(shot_cells);
+      } else {
+        heatmap->RecordShot(last_shot);
+      }
 
-    if (board.HasShot(target)) {
-      already_targeted_locations.emplace(target);
+      heatmap->UpdateRemainingShips();
     } else {
-      break;
+      heatmap.emplace(board);
+    }
+  }
+
+  if (targeting_mode == TargetingMode::MonteCarlo) {
+    const auto deadline = (move_attempt_budget > 0)
+                              ? std::chrono::steady_clock::time_point::max()
+                              : std::chrono::steady_clock::now() + move_time_budget;
+
+    if (!fleet_sampler.has_value()) {
+      sampler_generator.Seed(placement_generator.ChooseIndex(std::numeric_limits<int>::max()),
+                             fleet_sampler_stream);
+      fleet_sampler.emplace(board, sampler_generator);
     }
+
+    fleet_sampler->Update(deadline, (move_attempt_budget > 0) ? move_attempt_budget
+                                                              : std::numeric_limits<int>::max());
+  }
+
+  last_shot = ChooseFreeTarget();
+
+  return last_shot;
+}
+
+std::vector<Location> ComputerAi::ChooseVolley(const int count) {
+  const int volley_size = std::min(count, board.NotFiredCount());
+  std::vector<Location> volley;
+  volley.reserve(volley_size);
+
+  if (volley_size <= 0) {
+    return volley;
+  }
+
+  volley.push_back(ChooseNextShot());
+  planned_shots.Set(volley.back().x, volley.back().y);
+
+  // There is always a cell left that is neither shot nor planned, so these always find one.
+  while (static_cast<int>(volley.size()) < volley_size) {
+    volley.push_back(ChooseFreeTarget());
+    planned_shots.Set(volley.back().x, volley.back().y);
   }
 
-  last_shot = target;
-  already_targeted_locations.emplace(target);
+  for (const Location location : volley) {
+    planned_shots.Clear(location.x, location.y);
+  }
+
+  return volley;
+}
+
+// A target neither fired at nor planned for the current volley.
+Location ComputerAi::ChooseFreeTarget() {
+  Location target;
+
+  do {
+    target = ChooseTarget();
+  } while (board.HasShot(target) || IsPlanned(target));
 
   return target;
 }
 
 Location ComputerAi::ChooseTarget() {
+  if (targeting_mode == TargetingMode::Parity) {
+    std::vector<Location> targets = ParityTargets();
+
+    if (!targets.empty()) {
+      return placement_generator.ChooseLocation(targets);
+    }
+
+    return ChooseParityHuntTarget();
+  }
+
+  if (fleet_sampler.has_value()) {
+    std::vector<Location> locations = fleet_sampler->MostOccupiedLocations();
+    locations.erase(std::remove_if(locations.begin(), locations.end(),
+                                   [this](const Location location) {
+                                     return IsPlanned(location);
+                                   }),
+                    locations.end());
+
+    if (!locations.empty()) {
+      return placement_generator.ChooseLocation(locations);
+    }
+  }
+
   Location target;
 
   if (next_targets.empty()) {
-    target = placement_generator.ChooseLocation(board.NotFiredLocations());
+    target = ChooseHuntTarget();
   } else {
     target = next_targets.top();
     next_targets.pop();
@@ -82,15 +171,209 @@ Location ComputerAi::ChooseTarget() {
   return target;
 }
 
-void ComputerAi::TargetAllLocationsAroundShotIfHit(const Location location) {
-  if (board.HasShot(location)) {
-    if (board.IsMine(location)) {
-      for (const Location sub_location : All8LocationsAround(location)) {
-        if (!AlreadyTargetedLocation(sub_location)) {
-          TargetAllLocationsAroundShotIfHit(sub_location);
+Location ComputerAi::ChooseHuntTarget() {
+  if (heatmap.has_value()) {
+    return placement_generator.ChooseLocation(heatmap->HottestLocations(planned_shots));
+  }
+
+  return placement_generator.ChooseNotFiredLocation(board);
+}
+
+std::vector<int> ComputerAi::RemainingShipSizes() const {
+  std::vector<int> sizes;
+
+  for (const ShipTypeId ship_type_id : board.GetRemainingShipIds()) {
+    sizes.push_back(board.GetFleetRegistry().GetSize(ship_type_id));
+  }
+
+  std::sort(sizes.begin(), sizes.end());
+
+  return sizes;
+}
+
+// How many unresolved hits follow location in a row, stepping by step_x and step_y.
+int ComputerAi::CountUnresolvedHitsFrom(const Location location, const int step_x,
+                                        const int step_y) const {
+  int count = 0;
+
+  while (IsUnresolvedHit(Location(location.x + ((count + 1) * step_x),
+                                  location.y + ((count + 1) * step_y)))) {
+    ++count;
+  }
+
+  return count;
+}
+
+bool ComputerAi::IsUnresolvedHit(const Location location) const {
+  return board.IsWithinBounds(location) && unresolved_hit_cells.Test(location.x, location.y);
+}
+
+void ComputerAi::RecordParityShots(const std::vector<Location>& shot_cells) {
+  std::vector<Location> new_hits;
+
+  for (const Location location : shot_cells) {
+    if (board.IsHit(location) && !IsUnresolvedHit(location)) {
+      unresolved_hits.push_back(location);
+      unresolved_hit_cells.Set(location.x, location.y);
+      new_hits.push_back(location);
+    }
+  }
+
+  if (board.RemainingShipsCount() != static_cast<int>(remaining_ship_sizes->size())) {
+    const std::vector<int> sizes = RemainingShipSizes();
+    std::vector<int> sunk_sizes;
+    std::set_difference(remaining_ship_sizes->begin(), remaining_ship_sizes->end(),
+                        sizes.begin(), sizes.end(), std::back_inserter(sunk_sizes));
+    remaining_ship_sizes = sizes;
+
+    // One of the new hits sank each ship, so each is put down to a line of hits from one of them.
+    // A ship that can't be placed leaves its hits to be fired around until they run out of
+    // targets.
+    for (const int size : sunk_sizes) {
+      for (auto hit = new_hits.rbegin(); hit != new_hits.rend(); ++hit) {
+        if (ResolveSunkShip(*hit, size)) {
+          break;
         }
       }
-    } else if (board.IsHit(location)) {
+    }
+  }
+
+  // A hit with every cell around it fired at has no target to give, though it stays in the plane
+  // to keep lines of hits whole: the hit at an open end of a line keeps the line's targets.
+  unresolved_hits.erase(std::remove_if(unresolved_hits.begin(), unresolved_hits.end(),
+                                       [this](const Location hit) {
+                                         return !HasTargetAround(hit);
+                                       }),
+                        unresolved_hits.end());
+}
+
+bool ComputerAi::HasTargetAround(const Location location) const {
+  for (const Location around : All4LocationsAround(location)) {
+    if (IsValidLocation(around)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Takes back size hits in a line starting at hit, preferring a line exactly as long as the ship.
+bool ComputerAi::ResolveSunkShip(const Location hit, const int size) {
+  if (!IsUnresolvedHit(hit)) {
+    return false;
+  }
+
+  for (const bool is_exact_line : { true, false }) {
+    for (const Location step : { Location(1, 0), Location(0, 1) }) {
+      const int forward = CountUnresolvedHitsFrom(hit, step.x, step.y);
+      const int back = CountUnresolvedHitsFrom(hit, -step.x, -step.y);
+
+      if (is_exact_line && (back + forward + 1 != size)) {
+        continue;
+      }
+
+      const int direction = (forward >= size - 1) ? 1 : (back >= size - 1) ? -1 : 0;
+
+      if (direction == 0) {
+        continue;
+      }
+
+      for (int offset = 0; offset < size; ++offset) {
+        const Location cell(hit.x + (direction * offset * step.x),
+                            hit.y + (direction * offset * step.y));
+        const auto position = std::find(unresolved_hits.begin(), unresolved_hits.end(), cell);
+
+        if (position != unresolved_hits.end()) {
+          unresolved_hits.erase(position);
+        }
+
+        unresolved_hit_cells.Clear(cell.x, cell.y);
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ComputerAi::AddParityTarget(std::vector<Location>& targets, const Location location) const {
+  if (IsValidLocation(location) && !IsPlanned(location)) {
+    targets.push_back(location);
+  }
+}
+
+std::vector<Location> ComputerAi::ParityTargets() const {
+  std::vector<Location> targets;
+
+  // Two hits in a line give the ship's axis, so only the two ends of the line are worth a shot.
+  for (auto hit = unresolved_hits.rbegin(); hit != unresolved_hits.rend(); ++hit) {
+    for (const Location step : { Location(1, 0), Location(0, 1) }) {
+      const int forward = CountUnresolvedHitsFrom(*hit, step.x, step.y);
+      const int back = CountUnresolvedHitsFrom(*hit, -step.x, -step.y);
+
+      if (forward + back > 0) {
+        AddParityTarget(targets, Location(hit->x - ((back + 1) * step.x),
+                                          hit->y - ((back + 1) * step.y)));
+        AddParityTarget(targets, Location(hit->x + ((forward + 1) * step.x),
+                                          hit->y + ((forward + 1) * step.y)));
+      }
+
+      if (!targets.empty()) {
+        return targets;
+      }
+    }
+  }
+
+  // Otherwise every line through a single hit is still open, or a line was closed at both ends by
+  // ships lying side by side, and the cells around each hit are tried, newest hit first.
+  for (auto hit = unresolved_hits.rbegin(); hit != unresolved_hits.rend(); ++hit) {
+    for (const Location location : All4LocationsAround(*hit)) {
+      AddParityTarget(targets, location);
+    }
+
+    if (!targets.empty()) {
+      return targets;
+    }
+  }
+
+  return targets;
+}
+
+Location ComputerAi::ChooseParityHuntTarget() {
+  const int spacing = remaining_ship_sizes->empty() ? 1 : remaining_ship_sizes->front();
+
+  // While much of the lattice is left a few draws from the whole pool find it, which saves
+  // listing every cell left for each shot.
+  for (int draw = 0; draw < parity_hunt_draws; ++draw) {
+    const Location location = placement_generator.ChooseNotFiredLocation(board);
+
+    if (((location.x + location.y) % spacing == 0) && !IsPlanned(location)) {
+      return location;
+    }
+  }
+
+  std::vector<Location> targets;
+
+  for (int index = 0; index < board.NotFiredCount(); ++index) {
+    const Location location = board.NotFiredLocation(index);
+
+    if (((location.x + location.y) % spacing == 0) && !IsPlanned(location)) {
+      targets.push_back(location);
+    }
+  }
+
+  // Hits put down to the wrong ship can leave one afloat with the whole lattice fired at.
+  for (int index = 0; targets.empty() && (index < board.NotFiredCount()); ++index) {
+    AddParityTarget(targets, board.NotFiredLocation(index));
+  }
+
+  return placement_generator.ChooseLocation(targets);
+}
+
+void ComputerAi::TargetLocationsAroundHits(const std::vector<Location>& shot_cells) {
+  for (const Location location : shot_cells) {
+    if (!board.IsMine(location) && board.IsHit(location)) {
       TargetLocationsAround(location);
     }
   }
@@ -103,7 +386,7 @@ void ComputerAi::TargetLocationsAround(const Location location) {
 }
 
 void ComputerAi::AddTargetLocation(const Location location) {
-  if (IsValidLocation(location) && !AlreadyTargetedLocation(location)) {
+  if (IsValidLocation(location)) {
     next_targets.push(location);
   }
 }
@@ -1,35 +1,95 @@
 #ifndef SRC_BOARD_COMPUTER_AI_H
 #define SRC_BOARD_COMPUTER_AI_H
 
+#include <chrono>
+#include <optional>
 #include <stack>
-#include <set>
+#include <vector>
 
 #include "board/random-placement-generator.h"
+#include "fleet-sampler.h"
+#include "target-heatmap.h"
+
+enum class TargetingMode {
+  // Hunts by firing at a random location that hasn't been fired at yet.
+  Random,
+  // Hunts by firing at the location covered by the most possible positions of the remaining ships.
+  ProbabilityDensity,
+  // Fires at the location most often covered by a pool of sampled fleet layouts that agree with
+  // every shot so far, falling back to Random's hunt and target when no layout could be found.
+  MonteCarlo,
+  // Hunts on a lattice spaced by the smallest ship afloat, which every ship must cross, and once
+  // two hits line up only fires at the ends of their line, putting hits down to sunk ships.
+  Parity
+};
 
 class ComputerAi {
 public:
   explicit ComputerAi(Board& board, PlacementGenerator& placement_generator)
   : board(board), placement_generator(placement_generator) {}
 
+  static constexpr std::chrono::microseconds default_move_time_budget{ 20000 };
+  // Random draws Parity makes for a lattice cell before listing the lattice cells left.
+  static constexpr int parity_hunt_draws = 8;
+
+  void SetTargetingMode(const TargetingMode targeting_mode);
+  // Longest time ChooseNextShot spends sampling fleet layouts in MonteCarlo mode.
+  void SetMoveTimeBudget(const std::chrono::microseconds move_time_budget);
+  // Most layouts ChooseNextShot repairs or generates in MonteCarlo mode instead of the time budget,
+  // or 0 to go back to the time budget. The shots then only depend on the placement generator.
+  void SetMoveAttemptBudget(const int move_attempt_budget);
   Location ChooseNextShot();
+  // Plans a salvo turn's shots, to be fired together with Board::ShootMany before the next call:
+  // the first is ChooseNextShot's and the rest carry on with the same targeting without knowing
+  // where the earlier ones land. Never more than count, nor than the cells not fired at yet.
+  std::vector<Location> ChooseVolley(const int count);
 
 private:
   bool IsValidLocation(const Location location) const;
-  bool AlreadyTargetedLocation(const Location location) const;
+  bool IsPlanned(const Location location) const;
 
+  Location ChooseFreeTarget();
   Location ChooseTarget();
+  Location ChooseHuntTarget();
 
-  void TargetAllLocationsAroundShotIfHit(const Location location);
+  std::vector<int> RemainingShipSizes() const;
+  int CountUnresolvedHitsFrom(const Location location, const int step_x, const int step_y) const;
+  bool IsUnresolvedHit(const Location location) const;
+  void RecordParityShots(const std::vector<Location>& shot_cells);
+  bool HasTargetAround(const Location location) const;
+  bool ResolveSunkShip(const Location hit, const int size);
+  void AddParityTarget(std::vector<Location>& targets, const Location location) const;
+  std::vector<Location> ParityTargets() const;
+  Location ChooseParityHuntTarget();
+
+  void TargetLocationsAroundHits(const std::vector<Location>& shot_cells);
   void TargetLocationsAround(const Location location);
   void AddTargetLocation(const Location location);
 
 private:
   Board& board;
   PlacementGenerator& placement_generator;
+  TargetingMode targeting_mode = TargetingMode::Random;
+  std::chrono::microseconds move_time_budget = default_move_time_budget;
+  int move_attempt_budget = 0;
+  std::optional<TargetHeatmap> heatmap;
+  // The sampler draws from its own Philox stream, seeded from the placement generator when the
+  // sampler is made, so however much it samples leaves the placement generator's numbers alone.
+  static constexpr std::uint64_t fleet_sampler_stream = 1;
+  RandomPlacementGenerator sampler_generator{ 0, RandomEngine::Philox };
+  std::optional<FleetSampler> fleet_sampler;
 
   Location last_shot;
-  std::set<Location> already_targeted_locations;
   std::stack<Location> next_targets;
+  // The shots already chosen for the volley being planned.
+  BitPlane planned_shots;
+
+  // Parity mode's hits not yet put down to a sunk ship, as a plane and, oldest first, those that
+  // still have a cell around them to fire at. Also the sizes of the ships that were afloat when
+  // the last shot was looked at, smallest first.
+  BitPlane unresolved_hit_cells;
+  std::vector<Location> unresolved_hits;
+  std::optional<std::vector<int>> remaining_ship_sizes;
 };
 
 #endif // SRC_BOARD_COMPUTER_AI_H
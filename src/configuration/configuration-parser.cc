@@ -1,80 +1,262 @@
 #include "configuration-parser.h"
 
-#include <regex>
 #include <set>
 
+bool IsDigit(const char character) {
+  return (character >= '0') && (character <= '9');
+}
+
+bool IsShipNameCharacter(const char character) {
+  return ((character >= 'A') && (character <= 'Z')) ||
+         ((character >= 'a') && (character <= 'z')) ||
+         (character == ' ');
+}
+
+bool IsShipKeywordEnd(const char character) {
+  switch (character) {
+    case 'B': case 'b': case 'O': case 'o': case 'A': case 'a': case 'T': case 't':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Compares text with a lowercase keyword of the same length, ignoring case.
+bool IsKeyword(const std::string_view text, const std::string_view keyword) {
+  for (int index = 0; index < static_cast<int>(keyword.size()); ++index) {
+    char character = text[index];
+
+    if ((character >= 'A') && (character <= 'Z')) {
+      character += ('a' - 'A');
+    }
+
+    if (character != keyword[index]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Reads between one and nineteen digits starting at position, moving position past them.
+bool ReadWideNumber(const std::string_view text, std::size_t& position, std::uint64_t& value) {
+  constexpr static int max_digits = 19;
+
+  value = 0;
+  int digits = 0;
+
+  while ((position < text.size()) && IsDigit(text[position]) && (digits < max_digits)) {
+    value = (value * 10) + (text[position] - '0');
+    ++position;
+    ++digits;
+  }
+
+  return digits > 0;
+}
+
+// Reads between one and nine digits starting at position, moving position past them.
+bool ReadNumber(const std::string_view text, std::size_t& position, int& value) {
+  constexpr static int max_digits = 9;
+
+  value = 0;
+  int digits = 0;
+
+  while ((position < text.size()) && IsDigit(text[position]) && (digits < max_digits)) {
+    value = (value * 10) + (text[position] - '0');
+    ++position;
+    ++digits;
+  }
+
+  return digits > 0;
+}
+
+// Column of the word that ends just before the colon at index, counting from 1.
+int KeywordColumn(const std::string_view text, const std::size_t line_start, std::size_t index) {
+  while ((index > line_start) &&
+         IsShipNameCharacter(text[index - 1]) &&
+         (text[index - 1] != ' ')) {
+    --index;
+  }
+
+  return static_cast<int>(index - line_start) + 1;
+}
+
+void SkipOptionalSpace(const std::string_view text, std::size_t& position) {
+  if ((position < text.size()) && (text[position] == ' ')) {
+    ++position;
+  }
+}
+
 Configuration ConfigurationParser::Parse() {
-  ParseBoard();
-  ParseShips();
+  constexpr static std::string_view board_keyword = "board";
+  constexpr static std::string_view seed_keyword = "seed";
+
+  const std::string_view text = configuration_string;
+  int line = 1;
+  std::size_t line_start = 0;
+  std::size_t next_ship_start = 0;
+
+  for (std::size_t index = 0; index < text.size(); ++index) {
+    if (text[index] == '\n') {
+      ++line;
+      line_start = index + 1;
+      continue;
+    }
+
+    if (text[index] != ':') {
+      continue;
+    }
+
+    if (!has_board &&
+        (index >= line_start + board_keyword.size()) &&
+        IsKeyword(text.substr(index - board_keyword.size(), board_keyword.size()), board_keyword)) {
+      ParseBoard(index + 1, line, KeywordColumn(text, line_start, index));
+    }
+
+    if (!configuration.seed.has_value() &&
+        (index >= line_start + seed_keyword.size()) &&
+        IsKeyword(text.substr(index - seed_keyword.size(), seed_keyword.size()), seed_keyword)) {
+      ParseSeed(index + 1);
+    }
+
+    if ((index > line_start) &&
+        (index - 1 >= next_ship_start) &&
+        IsShipKeywordEnd(text[index - 1])) {
+      const std::size_t end = ParseShip(index + 1, line, KeywordColumn(text, line_start, index));
+
+      if (end != std::string_view::npos) {
+        next_ship_start = end;
+      }
+    }
+  }
+
+  ValidateBoard();
+  ValidateShips();
 
   return configuration;
 }
 
-void ConfigurationParser::ParseBoard() {
-  const std::regex board_regex("[Bb][Oo][Aa][Rr][Dd]: ?(\\d{0,9})x(\\d{0,9})");
+bool ConfigurationParser::ParseBoard(const std::size_t start, const int line, const int column) {
+  const std::string_view text = configuration_string;
+  std::size_t position = start;
+  int width = 0;
+  int height = 0;
 
-  std::smatch match;
-  if (std::regex_search(configuration_string, match, board_regex)) {
-    const std::string& width_string = match.str(1);
-    const std::string& height_string = match.str(2);
+  SkipOptionalSpace(text, position);
 
-    const int width = std::stoi(width_string);
-    const int height = std::stoi(height_string);
+  if (!ReadNumber(text, position, width) ||
+      (position >= text.size()) ||
+      (text[position] != 'x')) {
+    return false;
+  }
 
-    if ((width > 80) || (height > 80)) {
-      ReportError(ConfigurationError::BoardSizeTooBig);
-    } else if ((width < 5) || (height < 5)) {
-      ReportError(ConfigurationError::BoardSizeTooSmall);
-    }
+  ++position;
+
+  if (!ReadNumber(text, position, height)) {
+    return false;
+  }
+
+  has_board = true;
+  board_line = line;
+  board_column = column;
+  configuration.board_width = width;
+  configuration.board_height = height;
+
+  return true;
+}
+
+std::size_t ConfigurationParser::ParseShip(const std::size_t start, const int line,
+                                           const int column) {
+  const std::string_view text = configuration_string;
+  std::size_t position = start;
+
+  while ((position < text.size()) && IsShipNameCharacter(text[position])) {
+    ++position;
+  }
+
+  std::string_view name = text.substr(start, position - start);
+
+  // The space after the colon is optional, unless it is all there is of the name.
+  if ((name.size() > 1) && (name.front() == ' ')) {
+    name.remove_prefix(1);
+  }
+
+  if (name.empty() || (position >= text.size()) || (text[position] != ',')) {
+    return std::string_view::npos;
+  }
+
+  ++position;
+  SkipOptionalSpace(text, position);
 
-    configuration.board_width = width;
-    configuration.board_height = height;
-  } else {
-    ReportError(ConfigurationError::BoardSizeNotSpecified);
+  int size = 0;
+
+  if (!ReadNumber(text, position, size)) {
+    return std::string_view::npos;
+  }
+
+  ship_entries.push_back(ShipEntry{ ShipType{ std::string(name), size }, line, column });
+
+  return position;
+}
+
+bool ConfigurationParser::ParseSeed(const std::size_t start) {
+  const std::string_view text = configuration_string;
+  std::size_t position = start;
+  std::uint64_t seed = 0;
+
+  SkipOptionalSpace(text, position);
+
+  if (!ReadWideNumber(text, position, seed)) {
+    return false;
+  }
+
+  configuration.seed = seed;
+
+  return true;
+}
+
+void ConfigurationParser::ValidateBoard() {
+  if (!has_board) {
+    ReportError(ConfigurationError::BoardSizeNotSpecified, 0, 0);
     configuration.board_width = 10;
     configuration.board_height = 10;
+    return;
   }
-}
 
-void ConfigurationParser::ParseShips() {
-  const std::regex boat_regex("[BbOoAaTt]: ?([A-Za-z ]+), ?(\\d{0,9})");
-  std::set<char> ship_starting_letters_found;
+  const int width = configuration.board_width;
+  const int height = configuration.board_height;
 
-  const std::sregex_iterator regex_end;
-  for (std::sregex_iterator iterator(configuration_string.begin(),
-                                     configuration_string.end(),
-                                     boat_regex);
-       iterator != regex_end; ++iterator) {
-    const std::smatch& match = *iterator;
+  if ((width > 80) || (height > 80)) {
+    ReportError(ConfigurationError::BoardSizeTooBig, board_line, board_column);
+  } else if ((width < 5) || (height < 5)) {
+    ReportError(ConfigurationError::BoardSizeTooSmall, board_line, board_column);
+  }
+}
 
-    const std::string& ship_name = match.str(1);
-    const std::string& ship_size_string = match.str(2);
+void ConfigurationParser::ValidateShips() {
+  std::set<char> ship_starting_letters_found;
 
-    const char ship_name_start_letter = ship_name.at(0);
+  for (const ShipEntry& ship_entry : ship_entries) {
+    const ShipType& ship_type = ship_entry.ship_type;
+    const char ship_name_start_letter = ship_type.name.at(0);
 
     if (ship_starting_letters_found.find(ship_name_start_letter)
         != ship_starting_letters_found.end()) {
-      ReportError(ConfigurationError::MultipleShipsWithSameStartingLetter);
+      ReportError(ConfigurationError::MultipleShipsWithSameStartingLetter,
+                  ship_entry.line, ship_entry.column);
+    } else if (ship_type.size < 1) {
+      ReportError(ConfigurationError::ShipTooSmall, ship_entry.line, ship_entry.column);
+    } else if ((ship_type.size > configuration.board_height) ||
+               (ship_type.size > configuration.board_width)) {
+      ReportError(ConfigurationError::ShipTooBig, ship_entry.line, ship_entry.column);
     } else {
-      const int ship_size = std::stoi(ship_size_string);
-
-      if (ship_size < 1) {
-        ReportError(ConfigurationError::ShipTooSmall);
-      } else if ((ship_size > configuration.board_height) || (ship_size > configuration.board_width)) {
-        ReportError(ConfigurationError::ShipTooBig);
-      } else {
-        ShipType ship_type;
-        ship_type.name = ship_name;
-        ship_type.size = ship_size;
-
-        ship_starting_letters_found.emplace(ship_name_start_letter);
-        configuration.ship_types.emplace_back(ship_type);
-      }
+      ship_starting_letters_found.emplace(ship_name_start_letter);
+      configuration.ship_types.emplace_back(ship_type);
     }
   }
 
   if (configuration.ship_types.empty()) {
-    ReportError(ConfigurationError::NoShips);
+    ReportError(ConfigurationError::NoShips, 0, 0);
   }
 }
 
@@ -82,6 +264,12 @@ const std::vector<ConfigurationError>& ConfigurationParser::GetErrors() const {
   return errors;
 }
 
-void ConfigurationParser::ReportError(ConfigurationError configuration_error) {
+const std::vector<ConfigurationErrorPosition>& ConfigurationParser::GetErrorPositions() const {
+  return error_positions;
+}
+
+void ConfigurationParser::ReportError(ConfigurationError configuration_error, const int line,
+                                      const int column) {
   errors.emplace_back(configuration_error);
+  error_positions.push_back(ConfigurationErrorPosition{ configuration_error, line, column });
 }
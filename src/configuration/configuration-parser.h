@@ -2,6 +2,7 @@
 #define SRC_CONFIGURATION_CONFIGURATION_PARSER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "configuration.h"
@@ -16,6 +17,16 @@ enum class ConfigurationError {
   ShipTooSmall
 };
 
+// Where in the configuration file an error was found. Line and column start at 1, or are 0 for
+// errors about something missing from the whole file.
+struct ConfigurationErrorPosition {
+  ConfigurationError error;
+  int line;
+  int column;
+};
+
+// Reads "Board: {width}x{height}", "Boat: {name}, {size}" and the optional "Seed: {number}" entries
+// from anywhere in the file in a single pass, without regard for line breaks or surrounding text.
 class ConfigurationParser {
 public:
   explicit ConfigurationParser(std::string configuration_string)
@@ -23,16 +34,31 @@ public:
 
   Configuration Parse();
   const std::vector<ConfigurationError>& GetErrors() const;
+  const std::vector<ConfigurationErrorPosition>& GetErrorPositions() const;
 
 private:
-  void ParseBoard();
-  void ParseShips();
+  struct ShipEntry {
+    ShipType ship_type;
+    int line;
+    int column;
+  };
+
+  bool ParseBoard(const std::size_t start, const int line, const int column);
+  std::size_t ParseShip(const std::size_t start, const int line, const int column);
+  bool ParseSeed(const std::size_t start);
+  void ValidateBoard();
+  void ValidateShips();
 
-  void ReportError(ConfigurationError configuration_error);
+  void ReportError(ConfigurationError configuration_error, const int line, const int column);
 
   std::string configuration_string;
   Configuration configuration;
+  bool has_board = false;
+  int board_line = 0;
+  int board_column = 0;
+  std::vector<ShipEntry> ship_entries;
   std::vector<ConfigurationError> errors;
+  std::vector<ConfigurationErrorPosition> error_positions;
 };
 
 #endif // SRC_CONFIGURATION_CONFIGURATION_PARSER_H
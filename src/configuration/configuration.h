@@ -1,6 +1,8 @@
 #ifndef SRC_CONFIGURATION_CONFIGURATION_H
 #define SRC_CONFIGURATION_CONFIGURATION_H
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,6 +28,8 @@ struct Configuration {
   int board_height;
 
   std::vector<ShipType> ship_types;
+  // Seeds every game's random numbers when given, so that runs can be repeated.
+  std::optional<std::uint64_t> seed;
 };
 
 #endif // SRC_CONFIGURATION_CONFIGURATION_H
@@ -0,0 +1,10 @@
+#ifndef SRC_FIRE_MODE_H
+#define SRC_FIRE_MODE_H
+
+enum FireMode {
+  NORMAL,
+  SALVO,
+  HIDDEN_MINES
+};
+
+#endif // SRC_FIRE_MODE_H
@@ -0,0 +1,588 @@
+#include "fleet-sampler.h"
+
+#include <algorithm>
+
+Location SampledShipCell(const Location start, const Orientation orientation, const int offset) {
+  return (orientation == Orientation::Vertical) ? Location(start.x, start.y + offset)
+                                                : Location(start.x + offset, start.y);
+}
+
+FleetSampler::FleetSampler(const Board& board, PlacementGenerator& placement_generator)
+  : board(board),
+    placement_generator(placement_generator),
+    width(board.GetWidth()),
+    height(board.GetHeight()),
+    fleet(board.GetPlacedShips()),
+    occupancy(width * height, 0) {
+  int max_ship_size = 0;
+
+  for (const ShipType& ship_type : fleet) {
+    max_ship_size = std::max(max_ship_size, ship_type.size);
+  }
+
+  sunk_counts.assign(max_ship_size + 1, 0);
+  full_counts.assign(max_ship_size + 1, 0);
+  samples.reserve(max_samples);
+}
+
+void FleetSampler::Update(const std::chrono::steady_clock::time_point deadline,
+                          const int max_attempts) {
+  ScanBoard();
+  int attempts = 0;
+
+  // Layouts the new shots contradict are repaired while there is time, and dropped otherwise.
+  for (int index = 0; index < static_cast<int>(samples.size());) {
+    if (IsConsistent(samples[index])) {
+      ++index;
+      continue;
+    }
+
+    RemoveSample(samples[index]);
+
+    if ((attempts++ < max_attempts) &&
+        (std::chrono::steady_clock::now() < deadline) &&
+        RepairSample(samples[index]) &&
+        IsConsistent(samples[index])) {
+      AddSample(samples[index]);
+      ++index;
+    } else {
+      samples[index] = std::move(samples.back());
+      samples.pop_back();
+    }
+  }
+
+  Sample sample;
+
+  while ((static_cast<int>(samples.size()) < max_samples) &&
+         (attempts++ < max_attempts) &&
+         (std::chrono::steady_clock::now() < deadline)) {
+    bool is_generated = false;
+
+    // New layouts are variations of surviving ones when there are any, since generating one from
+    // nothing gets harder the more hits it has to explain.
+    if (samples.empty()) {
+      is_generated = GenerateSample(sample);
+    } else {
+      sample = samples[placement_generator.ChooseIndex(samples.size())];
+      is_generated = PerturbSample(sample);
+    }
+
+    if (is_generated && IsConsistent(sample)) {
+      AddSample(sample);
+      samples.push_back(sample);
+    }
+  }
+}
+
+int FleetSampler::SampleCount() const {
+  return samples.size();
+}
+
+int FleetSampler::GetOccupancy(const Location location) const {
+  return occupancy[CellIndex(location)];
+}
+
+std::vector<Location> FleetSampler::MostOccupiedLocations() const {
+  std::vector<Location> locations;
+  int max_occupancy = 1;
+
+  for (int x = 1; x <= width; ++x) {
+    for (int y = 1; y <= height; ++y) {
+      const Location location(x, y);
+      const int cell_occupancy = occupancy[CellIndex(location)];
+
+      if ((cell_occupancy < max_occupancy) || board.HasShot(location)) {
+        continue;
+      }
+
+      if (cell_occupancy > max_occupancy) {
+        max_occupancy = cell_occupancy;
+        locations.clear();
+      }
+
+      locations.push_back(location);
+    }
+  }
+
+  return locations;
+}
+
+int FleetSampler::CellIndex(const Location location) const {
+  return ((location.y - 1) * width) + (location.x - 1);
+}
+
+void FleetSampler::ScanBoard() {
+  hit_cells.clear();
+
+  for (int x = 1; x <= width; ++x) {
+    for (int y = 1; y <= height; ++y) {
+      if (board.IsHit(Location(x, y))) {
+        hit_cells.emplace_back(x, y);
+      }
+    }
+  }
+
+  // Ships of the same size are interchangeable, so only how many of each size sank matters.
+  std::fill(sunk_counts.begin(), sunk_counts.end(), 0);
+
+  for (const ShipType& ship_type : fleet) {
+    ++sunk_counts[ship_type.size];
+  }
+
+  for (const ShipTypeId ship_type_id : board.GetRemainingShipIds()) {
+    --sunk_counts[board.GetFleetRegistry().GetSize(ship_type_id)];
+  }
+}
+
+bool FleetSampler::IsConsistent(const Sample& sample) {
+  int covered_hits_count = 0;
+  std::fill(full_counts.begin(), full_counts.end(), 0);
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    const int size = fleet[ship].size;
+    int hits = 0;
+
+    for (int offset = 0; offset < size; ++offset) {
+      const Location cell = SampledShipCell(sample[ship].location, sample[ship].orientation,
+                                            offset);
+
+      if (board.HasShot(cell)) {
+        if (!board.IsHit(cell)) {
+          return false;
+        }
+
+        ++hits;
+      }
+    }
+
+    if (hits == size) {
+      ++full_counts[size];
+    }
+
+    covered_hits_count += hits;
+  }
+
+  // Ships never overlap within a layout, so this only holds if every hit is covered.
+  return (covered_hits_count == static_cast<int>(hit_cells.size())) &&
+         (full_counts == sunk_counts);
+}
+
+void FleetSampler::AddSample(const Sample& sample) {
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    for (int offset = 0; offset < fleet[ship].size; ++offset) {
+      ++occupancy[CellIndex(SampledShipCell(sample[ship].location, sample[ship].orientation,
+                                            offset))];
+    }
+  }
+}
+
+void FleetSampler::RemoveSample(const Sample& sample) {
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    for (int offset = 0; offset < fleet[ship].size; ++offset) {
+      --occupancy[CellIndex(SampledShipCell(sample[ship].location, sample[ship].orientation,
+                                            offset))];
+    }
+  }
+}
+
+bool FleetSampler::GenerateSample(Sample& sample) {
+  sample.assign(fleet.size(), Placement{ Location(), Orientation::Horizontal });
+  occupied_cells.Reset();
+  placed_ships.assign(fleet.size(), false);
+  covered_hits = 0;
+
+  return CompleteSample(sample);
+}
+
+// Keeps the ships that still agree with the board where they are and places the rest again. Hits
+// left uncovered free up every ship on the group of touching hits they belong to, since a new hit
+// next to old ones usually means a ship lies differently, plus one ship covering no hits of each
+// size in case it belongs to a ship nobody has found yet.
+bool FleetSampler::RepairSample(Sample& sample) {
+  LoadSample(sample);
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    if (CoversMiss(sample[ship], fleet[ship].size)) {
+      FreeShip(ship, sample);
+    }
+  }
+
+  if (covered_hits == static_cast<int>(hit_cells.size())) {
+    return CompleteSample(sample);
+  }
+
+  MarkUncoveredHitGroups();
+  const int first_ship = placement_generator.ChooseIndex(fleet.size());
+  std::fill(full_counts.begin(), full_counts.end(), 0);
+
+  for (int step = 0; step < static_cast<int>(fleet.size()); ++step) {
+    const int ship = (first_ship + step) % fleet.size();
+    const int size = fleet[ship].size;
+
+    if (!placed_ships[ship]) {
+      continue;
+    }
+
+    const int hits = CountHits(sample[ship], size);
+
+    if (((hits == 0) && (full_counts[size] == 0)) || IsOnHitGroup(sample[ship], size)) {
+      FreeShip(ship, sample);
+      full_counts[size] = full_counts[size] || (hits == 0);
+    }
+  }
+
+  return CompleteSample(sample);
+}
+
+// Marks every hit joined to an uncovered hit by a line of touching hits.
+void FleetSampler::MarkUncoveredHitGroups() {
+  hit_groups.Reset();
+  pending_hits.clear();
+
+  for (const Location hit : hit_cells) {
+    if (!occupied_cells.Test(hit.x, hit.y)) {
+      hit_groups.Set(hit.x, hit.y);
+      pending_hits.push_back(hit);
+    }
+  }
+
+  while (!pending_hits.empty()) {
+    const Location hit = pending_hits.back();
+    pending_hits.pop_back();
+
+    for (const Location neighbour : { Location(hit.x, hit.y - 1), Location(hit.x, hit.y + 1),
+                                      Location(hit.x - 1, hit.y), Location(hit.x + 1, hit.y) }) {
+      if (board.IsHit(neighbour) && !hit_groups.Test(neighbour.x, neighbour.y)) {
+        hit_groups.Set(neighbour.x, neighbour.y);
+        pending_hits.push_back(neighbour);
+      }
+    }
+  }
+}
+
+bool FleetSampler::IsOnHitGroup(const Placement& placement, const int size) const {
+  for (int offset = 0; offset < size; ++offset) {
+    const Location cell = SampledShipCell(placement.location, placement.orientation, offset);
+
+    if (hit_groups.Test(cell.x, cell.y)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool FleetSampler::PerturbSample(Sample& sample) {
+  LoadSample(sample);
+
+  for (int move = 0; move < perturbed_ships; ++move) {
+    const int ship = placement_generator.ChooseIndex(fleet.size());
+
+    if (placed_ships[ship]) {
+      FreeShip(ship, sample);
+    }
+  }
+
+  return CompleteSample(sample);
+}
+
+void FleetSampler::LoadSample(const Sample& sample) {
+  occupied_cells.Reset();
+  placed_ships.assign(fleet.size(), true);
+  covered_hits = 0;
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    covered_hits += SetCells(sample[ship], fleet[ship].size, true);
+  }
+}
+
+void FleetSampler::FreeShip(const int ship, const Sample& sample) {
+  placed_ships[ship] = false;
+  covered_hits -= SetCells(sample[ship], fleet[ship].size, false);
+}
+
+int FleetSampler::CountHits(const Placement& placement, const int size) const {
+  int hits = 0;
+
+  for (int offset = 0; offset < size; ++offset) {
+    if (board.IsHit(SampledShipCell(placement.location, placement.orientation, offset))) {
+      ++hits;
+    }
+  }
+
+  return hits;
+}
+
+bool FleetSampler::CoversMiss(const Placement& placement, const int size) const {
+  for (int offset = 0; offset < size; ++offset) {
+    const Location cell = SampledShipCell(placement.location, placement.orientation, offset);
+
+    if (board.HasShot(cell) && !board.IsHit(cell)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Decides which of the unplaced ships have to be placed sunk, so that together with the placed
+// ones the number of sunk ships of each size matches the board. Placed ships that are sunk beyond
+// that are freed first.
+bool FleetSampler::AssignSunkShips(Sample& sample) {
+  std::fill(full_counts.begin(), full_counts.end(), 0);
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    if (placed_ships[ship] && (CountHits(sample[ship], fleet[ship].size) == fleet[ship].size)) {
+      ++full_counts[fleet[ship].size];
+    }
+  }
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    const int size = fleet[ship].size;
+
+    if (placed_ships[ship] &&
+        (full_counts[size] > sunk_counts[size]) &&
+        (CountHits(sample[ship], size) == size)) {
+      FreeShip(ship, sample);
+      --full_counts[size];
+    }
+  }
+
+  sunk_ships.assign(fleet.size(), false);
+  unplaced_sunk_area = 0;
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    const int size = fleet[ship].size;
+
+    if (!placed_ships[ship] && (full_counts[size] < sunk_counts[size])) {
+      sunk_ships[ship] = true;
+      unplaced_sunk_area += size;
+      ++full_counts[size];
+    }
+  }
+
+  return full_counts == sunk_counts;
+}
+
+// Uncovered hits are covered one at a time in scan order, backtracking when one can no longer be
+// covered, so sunk ships end up on hits only. The ships still unplaced after that go anywhere that
+// doesn't cover a miss.
+bool FleetSampler::CompleteSample(Sample& sample) {
+  if (!AssignSunkShips(sample)) {
+    return false;
+  }
+
+  search_steps = 0;
+
+  if (!CoverHitsFrom(0, sample)) {
+    return false;
+  }
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    if (!placed_ships[ship] && !PlaceAfloatShip(ship, sample)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool FleetSampler::CoverHitsFrom(int hit_index, Sample& sample) {
+  while ((hit_index < static_cast<int>(hit_cells.size())) &&
+         occupied_cells.Test(hit_cells[hit_index].x, hit_cells[hit_index].y)) {
+    ++hit_index;
+  }
+
+  // Sunk ships only lie on hits, so they need at least as many hits as are left uncovered.
+  if (static_cast<int>(hit_cells.size()) - covered_hits < unplaced_sunk_area) {
+    return false;
+  }
+
+  if (hit_index == static_cast<int>(hit_cells.size())) {
+    return true;
+  }
+
+  std::vector<Candidate> options = CoveringCandidates(hit_cells[hit_index]);
+
+  for (int index = 0; index < static_cast<int>(options.size()); ++index) {
+    if (++search_steps > max_search_steps) {
+      return false;
+    }
+
+    // Lazily shuffles the untried options, one pick at a time.
+    const int pick = index + placement_generator.ChooseIndex(options.size() - index);
+    std::swap(options[index], options[pick]);
+
+    const Candidate& option = options[index];
+    Place(option.ship, option.placement, sample);
+
+    if (CoverHitsFrom(hit_index + 1, sample)) {
+      return true;
+    }
+
+    Unplace(option.ship, option.placement);
+  }
+
+  return false;
+}
+
+std::vector<FleetSampler::Candidate> FleetSampler::CoveringCandidates(const Location hit) const {
+  std::vector<Candidate> options;
+
+  for (int ship = 0; ship < static_cast<int>(fleet.size()); ++ship) {
+    if (placed_ships[ship] || HasEquivalentUnplacedShip(ship)) {
+      continue;
+    }
+
+    const int size = fleet[ship].size;
+    const bool is_sunk = sunk_ships[ship];
+
+    for (int offset = 0; offset < size; ++offset) {
+      const Placement horizontal{ Location(hit.x - offset, hit.y), Orientation::Horizontal };
+      const Placement vertical{ Location(hit.x, hit.y - offset), Orientation::Vertical };
+
+      if (Fits(horizontal, size, is_sunk)) {
+        options.push_back(Candidate{ ship, horizontal });
+      }
+
+      if ((size > 1) && Fits(vertical, size, is_sunk)) {
+        options.push_back(Candidate{ ship, vertical });
+      }
+    }
+  }
+
+  return options;
+}
+
+// Ships of the same size that are both sunk or both afloat are interchangeable, so only the first
+// unplaced one of each kind is offered.
+bool FleetSampler::HasEquivalentUnplacedShip(const int ship) const {
+  for (int other_ship = 0; other_ship < ship; ++other_ship) {
+    if (!placed_ships[other_ship] &&
+        (fleet[other_ship].size == fleet[ship].size) &&
+        (sunk_ships[other_ship] == sunk_ships[ship])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void FleetSampler::Place(const int ship, const Placement& placement, Sample& sample) {
+  sample[ship] = placement;
+  placed_ships[ship] = true;
+  covered_hits += SetCells(placement, fleet[ship].size, true);
+
+  if (sunk_ships[ship]) {
+    unplaced_sunk_area -= fleet[ship].size;
+  }
+}
+
+void FleetSampler::Unplace(const int ship, const Placement& placement) {
+  placed_ships[ship] = false;
+  covered_hits -= SetCells(placement, fleet[ship].size, false);
+
+  if (sunk_ships[ship]) {
+    unplaced_sunk_area += fleet[ship].size;
+  }
+}
+
+bool FleetSampler::PlaceAfloatShip(const int ship, Sample& sample) {
+  const int size = fleet[ship].size;
+
+  // A proposal drawn over the whole board that happens to fit saves enumerating every position.
+  for (int attempt = 0; attempt < max_proposals; ++attempt) {
+    Placement proposal{ placement_generator.GenerateLocation(width, height),
+                        placement_generator.GenerateOrientation() };
+
+    if (size == 1) {
+      proposal.orientation = Orientation::Horizontal;
+    }
+
+    if (Fits(proposal, size, false)) {
+      Place(ship, proposal, sample);
+      return true;
+    }
+  }
+
+  candidates.clear();
+
+  for (int x = 1; x <= width; ++x) {
+    for (int y = 1; y <= height; ++y) {
+      const Placement horizontal{ Location(x, y), Orientation::Horizontal };
+      const Placement vertical{ Location(x, y), Orientation::Vertical };
+
+      if (Fits(horizontal, size, false)) {
+        candidates.push_back(horizontal);
+      }
+
+      if ((size > 1) && Fits(vertical, size, false)) {
+        candidates.push_back(vertical);
+      }
+    }
+  }
+
+  return ChooseCandidate(ship, sample);
+}
+
+bool FleetSampler::Fits(const Placement& placement, const int size, const bool is_sunk) const {
+  const bool vertical = placement.orientation == Orientation::Vertical;
+  const int end_x = placement.location.x + (vertical ? 0 : size - 1);
+  const int end_y = placement.location.y + (vertical ? size - 1 : 0);
+
+  if ((placement.location.x < 1) || (placement.location.y < 1) ||
+      (end_x > width) || (end_y > height)) {
+    return false;
+  }
+
+  int hits = 0;
+
+  for (int offset = 0; offset < size; ++offset) {
+    const Location cell = SampledShipCell(placement.location, placement.orientation, offset);
+
+    if (occupied_cells.Test(cell.x, cell.y)) {
+      return false;
+    }
+
+    if (board.HasShot(cell)) {
+      if (!board.IsHit(cell)) {
+        return false;
+      }
+
+      ++hits;
+    }
+  }
+
+  return is_sunk ? (hits == size) : (hits < size);
+}
+
+bool FleetSampler::ChooseCandidate(const int ship, Sample& sample) {
+  if (candidates.empty()) {
+    return false;
+  }
+
+  Place(ship, candidates[placement_generator.ChooseIndex(candidates.size())], sample);
+
+  return true;
+}
+
+// Returns the number of hits under the placement.
+int FleetSampler::SetCells(const Placement& placement, const int size, const bool occupied) {
+  int hits = 0;
+
+  for (int offset = 0; offset < size; ++offset) {
+    const Location cell = SampledShipCell(placement.location, placement.orientation, offset);
+
+    if (occupied) {
+      occupied_cells.Set(cell.x, cell.y);
+    } else {
+      occupied_cells.Clear(cell.x, cell.y);
+    }
+
+    if (board.IsHit(cell)) {
+      ++hits;
+    }
+  }
+
+  return hits;
+}
@@ -0,0 +1,106 @@
+#ifndef SRC_FLEET_SAMPLER_H
+#define SRC_FLEET_SAMPLER_H
+
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#include "board/board.h"
+#include "board/placement-generator.h"
+
+// Keeps a pool of whole fleet layouts that agree with everything seen on the board so far: no ship
+// on a miss, every hit covered, sunk ships lying on hits only and ships afloat not yet fully hit.
+// Layouts contradicted by later shots are dropped and new ones are generated in their place for as
+// long as the time and attempt budgets allow, so the ones that survive carry over from move to
+// move.
+class FleetSampler {
+public:
+  static constexpr int max_samples = 256;
+  static constexpr int max_proposals = 16;
+  // Placements tried while covering hits before a layout is given up on and started over.
+  static constexpr int max_search_steps = 1024;
+  // Ships taken out and placed again to turn a surviving layout into a new one.
+  static constexpr int perturbed_ships = 4;
+
+  explicit FleetSampler(const Board& board, PlacementGenerator& placement_generator);
+
+  // Drops the layouts the board now contradicts, then generates new ones until the pool is full,
+  // the deadline has passed or max_attempts layouts have been repaired or generated. Only the
+  // attempt budget gives the same pool for the same random numbers every time.
+  void Update(const std::chrono::steady_clock::time_point deadline,
+              const int max_attempts = std::numeric_limits<int>::max());
+
+  int SampleCount() const;
+  // Number of layouts in the pool with a ship on the location.
+  int GetOccupancy(const Location location) const;
+  // All not yet fired locations that the most layouts put a ship on. Empty if no layout puts a
+  // ship on any of them, such as when the pool is empty.
+  std::vector<Location> MostOccupiedLocations() const;
+
+private:
+  struct Placement {
+    Location location;
+    Orientation orientation;
+  };
+
+  struct Candidate {
+    int ship;
+    Placement placement;
+  };
+
+  // One placement per ship of the fleet, in fleet order.
+  using Sample = std::vector<Placement>;
+
+  int CellIndex(const Location location) const;
+  void ScanBoard();
+  bool IsConsistent(const Sample& sample);
+  void AddSample(const Sample& sample);
+  void RemoveSample(const Sample& sample);
+
+  bool GenerateSample(Sample& sample);
+  bool RepairSample(Sample& sample);
+  void MarkUncoveredHitGroups();
+  bool IsOnHitGroup(const Placement& placement, const int size) const;
+  bool PerturbSample(Sample& sample);
+  void LoadSample(const Sample& sample);
+  void FreeShip(const int ship, const Sample& sample);
+  int CountHits(const Placement& placement, const int size) const;
+  bool CoversMiss(const Placement& placement, const int size) const;
+  bool AssignSunkShips(Sample& sample);
+  bool CompleteSample(Sample& sample);
+  bool CoverHitsFrom(int hit_index, Sample& sample);
+  std::vector<Candidate> CoveringCandidates(const Location hit) const;
+  bool HasEquivalentUnplacedShip(const int ship) const;
+  bool PlaceAfloatShip(const int ship, Sample& sample);
+  bool Fits(const Placement& placement, const int size, const bool is_sunk) const;
+  bool ChooseCandidate(const int ship, Sample& sample);
+  void Place(const int ship, const Placement& placement, Sample& sample);
+  void Unplace(const int ship, const Placement& placement);
+  int SetCells(const Placement& placement, const int size, const bool occupied);
+
+  const Board& board;
+  PlacementGenerator& placement_generator;
+  int width;
+  int height;
+  std::vector<ShipType> fleet;
+  // Number of sunk ships of each size.
+  std::vector<int> sunk_counts;
+  std::vector<Location> hit_cells;
+  std::vector<Sample> samples;
+  std::vector<int> occupancy;
+
+  // Search state, only valid during GenerateSample.
+  BitPlane occupied_cells;
+  std::vector<bool> placed_ships;
+  // Which unplaced ships have to be placed sunk.
+  std::vector<bool> sunk_ships;
+  std::vector<int> full_counts;
+  BitPlane hit_groups;
+  std::vector<Location> pending_hits;
+  std::vector<Placement> candidates;
+  int covered_hits = 0;
+  int unplaced_sunk_area = 0;
+  int search_steps = 0;
+};
+
+#endif // SRC_FLEET_SAMPLER_H
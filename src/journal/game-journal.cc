@@ -0,0 +1,118 @@
+#include "game-journal.h"
+
+#include <algorithm>
+
+GameJournal::GameJournal(const std::string& path) {
+  file = std::fopen(path.c_str(), "ab");
+
+  if ((file != nullptr) && (std::ftell(file) == 0)) {
+    if (std::fwrite(journal_magic.data(), 1, journal_magic.size(), file) != journal_magic.size()) {
+      std::fclose(file);
+      file = nullptr;
+    }
+  }
+}
+
+GameJournal::~GameJournal() {
+  if (file != nullptr) {
+    std::fclose(file);
+  }
+}
+
+bool GameJournal::IsOpen() const {
+  return file != nullptr;
+}
+
+bool GameJournal::Append(const GameRecord& record) {
+  if (file == nullptr) {
+    return false;
+  }
+
+  record_bytes.clear();
+  EncodeGameRecord(record, record_bytes);
+
+  framed_bytes.clear();
+  AppendVarint(framed_bytes, record_bytes.size());
+  framed_bytes += record_bytes;
+
+  return (std::fwrite(framed_bytes.data(), 1, framed_bytes.size(), file) == framed_bytes.size()) &&
+         (std::fflush(file) == 0);
+}
+
+ShotResult RecordedShotResult(const Board& board, const Location location) {
+  if (board.IsMine(location)) {
+    return ShotResult::Mine;
+  } else if (board.IsHit(location)) {
+    return ShotResult::Hit;
+  }
+
+  return ShotResult::Miss;
+}
+
+void GameRecorder::Begin(const Configuration& configuration,
+                         const std::uint64_t seed,
+                         const RandomEngine random_engine,
+                         const FireMode fire_mode,
+                         const Board& board_1,
+                         const Board& board_2) {
+  boards = { &board_1, &board_2 };
+  record.summary = GameSummary();
+  record.summary.configuration_hash = ConfigurationHash(configuration);
+  record.summary.seed = seed;
+  record.summary.random_engine = random_engine;
+  record.summary.fire_mode = fire_mode;
+  record.summary.width = board_1.GetWidth();
+  record.summary.height = board_1.GetHeight();
+  record.shots.clear();
+
+  for (int board = 0; board < 2; ++board) {
+    record.boats[board].clear();
+    record.mines[board].clear();
+
+    for (const BoatPlacement& boat_placement : boards[board]->GetBoatPlacements()) {
+      const auto ship_type = std::find(configuration.ship_types.begin(),
+                                       configuration.ship_types.end(),
+                                       boat_placement.ship_type);
+
+      record.boats[board].push_back(
+          JournalBoat{ static_cast<int>(ship_type - configuration.ship_types.begin()),
+                       boat_placement.start_location,
+                       boat_placement.orientation });
+    }
+
+    for (int y = 1; y <= record.summary.height; ++y) {
+      for (int x = 1; x <= record.summary.width; ++x) {
+        if (boards[board]->IsMine(Location(x, y))) {
+          record.mines[board].emplace_back(x, y);
+        }
+      }
+    }
+  }
+
+  is_recording = true;
+}
+
+void GameRecorder::RecordShot(const Board& target_board, const Location location) {
+  if (!is_recording) {
+    return;
+  }
+
+  const int board = (&target_board == boards[0]) ? 0 : 1;
+  const ShotResult result = RecordedShotResult(target_board, location);
+
+  record.shots.push_back(JournalShot{ board, location, result });
+}
+
+void GameRecorder::Finish(const int winner) {
+  record.summary.winner = winner;
+  record.summary.shot_count = record.shots.size();
+  is_recording = false;
+}
+
+bool GameRecorder::IsRecording() const {
+  return is_recording;
+}
+
+const GameRecord& GameRecorder::GetRecord() const {
+  return record;
+}
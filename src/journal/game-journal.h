@@ -0,0 +1,55 @@
+#ifndef SRC_JOURNAL_GAME_JOURNAL_H
+#define SRC_JOURNAL_GAME_JOURNAL_H
+
+#include <cstdio>
+#include <string>
+
+#include "game-record.h"
+
+// Appends game records to a journal file, starting the file if it is empty. Each record is written
+// and flushed with a single write, so a journal cut short by a crash only loses its last record.
+class GameJournal {
+public:
+  explicit GameJournal(const std::string& path);
+  ~GameJournal();
+
+  GameJournal(const GameJournal&) = delete;
+  GameJournal& operator=(const GameJournal&) = delete;
+
+  bool IsOpen() const;
+  bool Append(const GameRecord& record);
+
+private:
+  std::FILE* file = nullptr;
+  // Reused between records.
+  std::string record_bytes;
+  std::string framed_bytes;
+};
+
+// What a shot that was just fired at location found there.
+ShotResult RecordedShotResult(const Board& board, const Location location);
+
+// Builds the record of a game as it is played. Begin takes both boards once their boats and mines
+// are in place, and every accepted shot is then passed to RecordShot.
+class GameRecorder {
+public:
+  void Begin(const Configuration& configuration,
+             const std::uint64_t seed,
+             const RandomEngine random_engine,
+             const FireMode fire_mode,
+             const Board& board_1,
+             const Board& board_2);
+  void RecordShot(const Board& target_board, const Location location);
+  // winner is 1 or 2, or 0 if the game was quit.
+  void Finish(const int winner);
+
+  bool IsRecording() const;
+  const GameRecord& GetRecord() const;
+
+private:
+  std::array<const Board*, 2> boards{};
+  GameRecord record;
+  bool is_recording = false;
+};
+
+#endif // SRC_JOURNAL_GAME_JOURNAL_H
@@ -0,0 +1,250 @@
+#include "game-record.h"
+
+#include "shared.h"
+
+constexpr int hash_size = 8;
+
+void AppendVarint(std::string& bytes, std::uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+
+  bytes.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const std::string_view bytes, std::size_t& position, std::uint64_t& value) {
+  constexpr static int max_shift = 63;
+
+  value = 0;
+
+  for (int shift = 0; (shift <= max_shift) && (position < bytes.size()); shift += 7) {
+    const auto byte = static_cast<std::uint8_t>(bytes[position++]);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Reads a varint no larger than limit.
+bool ReadBoundedVarint(const std::string_view bytes, std::size_t& position,
+                       const std::uint64_t limit, int& value) {
+  std::uint64_t wide_value;
+
+  if (!ReadVarint(bytes, position, wide_value) || (wide_value > limit)) {
+    return false;
+  }
+
+  value = static_cast<int>(wide_value);
+
+  return true;
+}
+
+// Maps small negative and positive differences alike to small unsigned values.
+std::uint64_t ZigZagEncode(const std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t ZigZagDecode(const std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+int RecordCellIndex(const GameSummary& summary, const Location location) {
+  return ((location.y - 1) * summary.width) + (location.x - 1);
+}
+
+Location RecordCellLocation(const GameSummary& summary, const int cell) {
+  return Location((cell % summary.width) + 1, (cell / summary.width) + 1);
+}
+
+std::uint64_t ConfigurationHash(const Configuration& configuration) {
+  constexpr static std::uint64_t offset_basis = 0xCBF29CE484222325ULL;
+  constexpr static std::uint64_t prime = 0x100000001B3ULL;
+
+  std::uint64_t hash = offset_basis;
+
+  const auto add_number = [&hash](const int number) {
+    for (int byte = 0; byte < 4; ++byte) {
+      hash = (hash ^ ((static_cast<std::uint32_t>(number) >> (8 * byte)) & 0xFF)) * prime;
+    }
+  };
+
+  add_number(configuration.board_width);
+  add_number(configuration.board_height);
+
+  for (const ShipType& ship_type : configuration.ship_types) {
+    for (const char character : ship_type.name) {
+      hash = (hash ^ static_cast<std::uint8_t>(character)) * prime;
+    }
+
+    // A zero byte ends the name, so that names running into sizes can't collide.
+    hash *= prime;
+    add_number(ship_type.size);
+  }
+
+  return hash;
+}
+
+void EncodeGameRecord(const GameRecord& record, std::string& bytes) {
+  const GameSummary& summary = record.summary;
+
+  for (int byte = 0; byte < hash_size; ++byte) {
+    bytes.push_back(static_cast<char>((summary.configuration_hash >> (8 * byte)) & 0xFF));
+  }
+
+  AppendVarint(bytes, summary.seed);
+  AppendVarint(bytes, static_cast<std::uint64_t>(summary.random_engine));
+  AppendVarint(bytes, summary.fire_mode);
+  AppendVarint(bytes, summary.width);
+  AppendVarint(bytes, summary.height);
+  AppendVarint(bytes, summary.winner);
+  AppendVarint(bytes, record.shots.size());
+
+  for (int board = 0; board < 2; ++board) {
+    AppendVarint(bytes, record.boats[board].size());
+
+    for (const JournalBoat& boat : record.boats[board]) {
+      const int cell = RecordCellIndex(summary, boat.start_location);
+
+      AppendVarint(bytes, boat.ship_type);
+      AppendVarint(bytes, (cell << 1) | (boat.orientation == Orientation::Vertical ? 1 : 0));
+    }
+
+    AppendVarint(bytes, record.mines[board].size());
+
+    for (const Location mine : record.mines[board]) {
+      AppendVarint(bytes, RecordCellIndex(summary, mine));
+    }
+  }
+
+  std::array<int, 2> previous_cells{};
+
+  for (const JournalShot& shot : record.shots) {
+    const int cell = RecordCellIndex(summary, shot.location);
+    const std::uint64_t delta = ZigZagEncode(cell - previous_cells[shot.board]);
+    previous_cells[shot.board] = cell;
+
+    const std::uint64_t result = static_cast<std::uint64_t>(shot.result);
+
+    AppendVarint(bytes, (delta << 3) | (result << 1) | shot.board);
+  }
+}
+
+bool DecodeSummaryFrom(const std::string_view bytes, std::size_t& position, GameSummary& summary) {
+  if (bytes.size() < hash_size) {
+    return false;
+  }
+
+  summary.configuration_hash = 0;
+
+  for (int byte = 0; byte < hash_size; ++byte) {
+    summary.configuration_hash |=
+        static_cast<std::uint64_t>(static_cast<std::uint8_t>(bytes[byte])) << (8 * byte);
+  }
+
+  position = hash_size;
+  int random_engine;
+  int fire_mode;
+
+  if (!ReadVarint(bytes, position, summary.seed) ||
+      !ReadBoundedVarint(bytes, position, static_cast<int>(RandomEngine::Philox), random_engine) ||
+      !ReadBoundedVarint(bytes, position, HIDDEN_MINES, fire_mode) ||
+      !ReadBoundedVarint(bytes, position, max_coordinate, summary.width) ||
+      !ReadBoundedVarint(bytes, position, max_coordinate, summary.height) ||
+      !ReadBoundedVarint(bytes, position, 2, summary.winner) ||
+      !ReadBoundedVarint(bytes, position, bytes.size(), summary.shot_count)) {
+    return false;
+  }
+
+  summary.random_engine = static_cast<RandomEngine>(random_engine);
+  summary.fire_mode = static_cast<FireMode>(fire_mode);
+
+  return (summary.width > 0) && (summary.height > 0);
+}
+
+bool DecodeGameSummary(const std::string_view bytes, GameSummary& summary) {
+  std::size_t position = 0;
+
+  return DecodeSummaryFrom(bytes, position, summary);
+}
+
+bool DecodeGameRecord(const std::string_view bytes, const int ship_type_count, GameRecord& record) {
+  GameSummary& summary = record.summary;
+  std::size_t position = 0;
+
+  if (!DecodeSummaryFrom(bytes, position, summary)) {
+    return false;
+  }
+
+  const int cell_count = summary.width * summary.height;
+
+  for (int board = 0; board < 2; ++board) {
+    int boat_count;
+    int mine_count;
+
+    if (!ReadBoundedVarint(bytes, position, cell_count, boat_count)) {
+      return false;
+    }
+
+    record.boats[board].resize(boat_count);
+
+    for (JournalBoat& boat : record.boats[board]) {
+      int placement;
+
+      if (!ReadBoundedVarint(bytes, position, cell_count, boat.ship_type) ||
+          (boat.ship_type >= ship_type_count) ||
+          !ReadBoundedVarint(bytes, position, (2 * cell_count) - 1, placement)) {
+        return false;
+      }
+
+      boat.start_location = RecordCellLocation(summary, placement >> 1);
+      boat.orientation = (placement & 1) ? Orientation::Vertical : Orientation::Horizontal;
+    }
+
+    if (!ReadBoundedVarint(bytes, position, cell_count, mine_count)) {
+      return false;
+    }
+
+    record.mines[board].resize(mine_count);
+
+    for (Location& mine : record.mines[board]) {
+      int cell;
+
+      if (!ReadBoundedVarint(bytes, position, cell_count - 1, cell)) {
+        return false;
+      }
+
+      mine = RecordCellLocation(summary, cell);
+    }
+  }
+
+  record.shots.resize(summary.shot_count);
+  std::array<int, 2> previous_cells{};
+
+  for (JournalShot& shot : record.shots) {
+    std::uint64_t value;
+
+    if (!ReadVarint(bytes, position, value)) {
+      return false;
+    }
+
+    const int board = value & 1;
+    const int result = (value >> 1) & 3;
+    const std::int64_t cell = previous_cells[board] + ZigZagDecode(value >> 3);
+
+    if ((result > static_cast<int>(ShotResult::Mine)) || (cell < 0) || (cell >= cell_count)) {
+      return false;
+    }
+
+    previous_cells[board] = static_cast<int>(cell);
+    shot.board = board;
+    shot.location = RecordCellLocation(summary, static_cast<int>(cell));
+    shot.result = static_cast<ShotResult>(result);
+  }
+
+  return position == bytes.size();
+}
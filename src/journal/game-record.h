@@ -0,0 +1,82 @@
+#ifndef SRC_JOURNAL_GAME_RECORD_H
+#define SRC_JOURNAL_GAME_RECORD_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board/board.h"
+#include "board/random-placement-generator.h"
+#include "configuration/configuration.h"
+#include "fire-mode.h"
+
+// Every journal file starts with these bytes, followed by the records of its games, each one
+// prefixed by its length in bytes as a varint.
+constexpr std::string_view journal_magic = "ASJ2";
+
+enum class ShotResult : std::uint8_t {
+  Miss,
+  Hit,
+  Mine
+};
+
+struct JournalBoat {
+  // Position of the boat's type in the configuration's ship types.
+  int ship_type;
+  Location start_location;
+  Orientation orientation;
+};
+
+struct JournalShot {
+  // The board that was fired at: 0 for player 1's, 1 for player 2's.
+  int board;
+  Location location;
+  // What was at the fired location, not counting any cells a mine chain reaction went on to.
+  ShotResult result;
+};
+
+// The part of a record that comes first, so that it can be read without decoding the rest.
+struct GameSummary {
+  std::uint64_t configuration_hash = 0;
+  std::uint64_t seed = 0;
+  // The engine the seed drives, which together with the seed reproduces the game's placements.
+  RandomEngine random_engine = RandomEngine::MersenneTwister;
+  FireMode fire_mode = NORMAL;
+  int width = 0;
+  int height = 0;
+  // 1 or 2 for the winning player, 0 if the game was quit before it ended.
+  int winner = 0;
+  int shot_count = 0;
+};
+
+// A record holds, after the summary, each board's boats and mines and then every accepted shot in
+// the order it was fired. Cells are written as (y - 1) * width + (x - 1), a shot as the zigzag
+// encoded difference from the previous shot at the same board with the result and the board in
+// its low three bits, and every number as a little-endian base 128 varint, apart from the
+// configuration hash which takes a fixed eight bytes. A typical 10x10 game fits in about 150 bytes.
+struct GameRecord {
+  GameSummary summary;
+  std::array<std::vector<JournalBoat>, 2> boats;
+  std::array<std::vector<Location>, 2> mines;
+  std::vector<JournalShot> shots;
+};
+
+void AppendVarint(std::string& bytes, std::uint64_t value);
+// Reads the varint at position, moving position past it.
+bool ReadVarint(const std::string_view bytes, std::size_t& position, std::uint64_t& value);
+
+// FNV-1a over the board size and every ship type, so that a record is only replayed with the
+// configuration it was played with.
+std::uint64_t ConfigurationHash(const Configuration& configuration);
+
+// Appends the record's bytes, without the length prefix.
+void EncodeGameRecord(const GameRecord& record, std::string& bytes);
+bool DecodeGameSummary(const std::string_view bytes, GameSummary& summary);
+// Reuses the storage of the record's vectors, so decoding many records into the same one doesn't
+// allocate once it has grown to fit them. Fails on a boat whose type isn't one of the
+// configuration's ship_type_count types.
+bool DecodeGameRecord(const std::string_view bytes, const int ship_type_count, GameRecord& record);
+
+#endif // SRC_JOURNAL_GAME_RECORD_H
@@ -0,0 +1,92 @@
+#include "journal-reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+JournalReader::JournalReader(const std::string& path) {
+  const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (descriptor < 0) {
+    return;
+  }
+
+  struct stat file_status{};
+
+  if (fstat(descriptor, &file_status) == 0) {
+    size = file_status.st_size;
+
+    if (size == 0) {
+      // A journal nothing has been written to yet.
+      is_open = true;
+    } else {
+      void* const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+      if (mapping != MAP_FAILED) {
+        data = static_cast<const char*>(mapping);
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        is_open = std::string_view(data, size).substr(0, journal_magic.size()) == journal_magic;
+      }
+    }
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(descriptor);
+
+  if (is_open) {
+    IndexRecords();
+  }
+}
+
+JournalReader::~JournalReader() {
+  if (data != nullptr) {
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+void JournalReader::IndexRecords() {
+  const std::string_view bytes(data, size);
+  std::size_t position = journal_magic.size();
+
+  while (position < bytes.size()) {
+    std::uint64_t length;
+
+    if (!ReadVarint(bytes, position, length) || (length > bytes.size() - position)) {
+      has_truncated_record = true;
+      return;
+    }
+
+    records.push_back(bytes.substr(position, length));
+    position += length;
+  }
+}
+
+bool JournalReader::IsOpen() const {
+  return is_open;
+}
+
+int JournalReader::GetGameCount() const {
+  return records.size();
+}
+
+bool JournalReader::HasTruncatedRecord() const {
+  return has_truncated_record;
+}
+
+bool JournalReader::ReadSummary(const int game, GameSummary& summary) const {
+  if ((game < 0) || (game >= static_cast<int>(records.size()))) {
+    return false;
+  }
+
+  return DecodeGameSummary(records[game], summary);
+}
+
+bool JournalReader::ReadGame(const int game, const int ship_type_count,
+                             GameRecord& record) const {
+  if ((game < 0) || (game >= static_cast<int>(records.size()))) {
+    return false;
+  }
+
+  return DecodeGameRecord(records[game], ship_type_count, record);
+}
@@ -0,0 +1,41 @@
+#ifndef SRC_JOURNAL_JOURNAL_READER_H
+#define SRC_JOURNAL_JOURNAL_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "game-record.h"
+
+// Memory-maps a journal file and finds where each record starts by skipping from length prefix to
+// length prefix, so opening a journal of millions of games only touches a few bytes of each.
+// Records are decoded straight from the mapping when asked for. A record cut short at the end of
+// the file is left out.
+class JournalReader {
+public:
+  explicit JournalReader(const std::string& path);
+  ~JournalReader();
+
+  JournalReader(const JournalReader&) = delete;
+  JournalReader& operator=(const JournalReader&) = delete;
+
+  bool IsOpen() const;
+  int GetGameCount() const;
+  // True if the file ends part way through a record, e.g. because its writer was interrupted.
+  bool HasTruncatedRecord() const;
+
+  // game counts from 0.
+  bool ReadSummary(const int game, GameSummary& summary) const;
+  bool ReadGame(const int game, const int ship_type_count, GameRecord& record) const;
+
+private:
+  void IndexRecords();
+
+  const char* data = nullptr;
+  std::size_t size = 0;
+  bool is_open = false;
+  bool has_truncated_record = false;
+  std::vector<std::string_view> records;
+};
+
+#endif // SRC_JOURNAL_JOURNAL_READER_H
@@ -1,65 +1,83 @@
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <optional>
-#include <regex>
+#include <random>
+#include <string_view>
+#include <type_traits>
 
 #include "board/auto-placer.h"
 #include "board/random-placement-generator.h"
 #include "board-renderer/board-renderer.h"
 #include "configuration/configuration-parser.h"
 #include "computer-ai.h"
+#include "fire-mode.h"
+#include "journal/game-journal.h"
+#include "journal/journal-reader.h"
+#include "profiling/profiler.h"
+#include "profiling/tracer.h"
+#include "server/session-server.h"
+#include "shared.h"
+#include "terminal/terminal-output.h"
+
+TerminalOutput terminal_output;
+// Only open when games are being journaled.
+std::optional<GameJournal> game_journal;
+GameRecorder game_recorder;
+// Every game's seed is mixed from the master seed and the number of games started before it.
+std::uint64_t master_seed = 0;
+std::uint64_t games_started = 0;
+RandomEngine random_engine = RandomEngine::MersenneTwister;
+// The configuration's ship types, numbered once for every board.
+FleetRegistry fleet_registry;
+// Only set when the game is being traced.
+const char* trace_path = nullptr;
+// How the computer players pick their shots, from --targeting.
+TargetingMode targeting_mode = TargetingMode::Random;
 
 void ClearScreen() {
-  std::cout << "\033c";
+  terminal_output.Clear();
 }
 
 template<typename T>
-void Print(const T value) {
-  std::cout << std::to_string(value);
-}
-
-template<>
-void Print(const std::string value) {
-  std::cout << value;
-}
-
-template<>
-void Print(const std::string_view value) {
-  std::cout << value;
-}
-
-template<>
-void Print(const char* value) {
-  std::cout << value;
+void Print(const T& value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    terminal_output.Write(std::to_string(value));
+  } else {
+    terminal_output.Write(std::string_view(value));
+  }
 }
 
 template<typename T>
-void PrintLine(const T value) {
-  std::cout << std::to_string(value) << "\n";
-}
-
-template<>
-void PrintLine(const std::string value) {
-  std::cout << value << "\n";
-}
-
-template<>
-void PrintLine(const char* value) {
-  std::cout << value << "\n";
+void PrintLine(const T& value) {
+  Print(value);
+  terminal_output.Write("\n");
 }
 
 void PrintLine() {
-  std::cout << "\n";
+  terminal_output.Write("\n");
 }
 
 void PrintBoard(const BoardRenderer& board_renderer) {
+  TRACE_SPAN("PrintBoard");
   ClearScreen();
   PrintLine(board_renderer.Render());
 }
 
 std::string GetLine() {
+  {
+    TRACE_SPAN("Flush");
+    terminal_output.Flush();
+  }
+
+  TRACE_SPAN("GetLine");
   std::string line;
   std::getline(std::cin, line);
+
+  terminal_output.EchoInput(line);
+
   return line;
 }
 
@@ -76,6 +94,7 @@ std::optional<std::string> ReadFile(const char* const name) {
 }
 
 Configuration ReadConfiguration() {
+  TRACE_SPAN("ReadConfiguration");
   const std::optional<std::string> configuration_string = ReadFile("adaship_config.ini");
 
   if (configuration_string.has_value()) {
@@ -121,7 +140,16 @@ Configuration ReadConfiguration() {
     }
 
     PrintLine("Detected errors with configuration file.");
-    for (auto error : configuration_parser.GetErrors()) {
+    for (const ConfigurationErrorPosition& error_position :
+         configuration_parser.GetErrorPositions()) {
+      const ConfigurationError error = error_position.error;
+
+      if (error_position.line > 0) {
+        Print("Line ");
+        Print(error_position.line);
+        Print(": ");
+      }
+
       if (error == ConfigurationError::BoardSizeNotSpecified) {
         PrintLine("Board size not specified.");
       } else if (error == ConfigurationError::MultipleShipsWithSameStartingLetter) {
@@ -169,6 +197,27 @@ struct ShipPlacement {
   Location location;
 };
 
+// Whole numbers of up to nine digits, so that they always fit in an int.
+std::optional<int> ParseChoiceNumber(const std::string_view text) {
+  constexpr static int max_digits = 9;
+
+  if (text.empty() || (text.size() > max_digits)) {
+    return std::nullopt;
+  }
+
+  int value = 0;
+
+  for (const char character : text) {
+    if ((character < '0') || (character > '9')) {
+      return std::nullopt;
+    }
+
+    value = (10 * value) + (character - '0');
+  }
+
+  return value;
+}
+
 std::optional<ShipChoice*> ChooseShipType(std::vector<ShipChoice>& ship_choices) {
   PrintLine("Choose a ship to place:");
 
@@ -192,8 +241,8 @@ std::optional<ShipChoice*> ChooseShipType(std::vector<ShipChoice>& ship_choices)
 
   const std::string choice = GetLine();
 
-  if (std::regex_match(choice, std::regex("\\d+"))) {
-    const int choice_int = std::stoi(choice);
+  if (const auto choice_number = ParseChoiceNumber(choice)) {
+    const int choice_int = *choice_number;
 
     if ((choice_int > 0) && (choice_int <= ship_choices.size())) {
       ShipChoice& ship_choice = ship_choices.at(choice_int - 1);
@@ -231,27 +280,13 @@ std::optional<Location> ChooseLocation(const Configuration& configuration) {
 
   const std::string choice = GetLine();
 
-  std::string column;
-  int row;
+  Coordinate coordinate;
 
-  std::smatch regex_match;
-  if (std::regex_match(choice, regex_match, std::regex(R"(^([A-Za-z]{1,2})(\d{1,2})$)"))) {
-    column = regex_match.str(1);
-    row = std::stoi(regex_match.str(2));
-  } else if (std::regex_match(choice, regex_match, std::regex(R"(^(\d{1,2})([A-Za-z]{1,2})$)"))) {
-    row = std::stoi(regex_match.str(1));
-    column = regex_match.str(2);
-  } else {
+  if (ParseCoordinate(choice, coordinate) != CoordinateError::None) {
     return std::nullopt;
   }
 
-  Location location;
-
-  try {
-    location = BoardLocation(column, row);
-  } catch (const std::runtime_error&) {
-    return std::nullopt;
-  }
+  const Location location(coordinate.column, coordinate.row);
 
   if ((location.x <= 0) ||
       (location.y <= 0) ||
@@ -344,6 +379,7 @@ bool InitializeBoard(const Configuration& configuration,
                      Board& user_board,
                      BoardRenderer& user_board_renderer,
                      PlacementGenerator& placement_generator) {
+  TRACE_SPAN("InitializeBoard");
   std::vector<ShipChoice> ship_choices;
   std::transform(configuration.ship_types.begin(),
                  configuration.ship_types.end(),
@@ -455,17 +491,108 @@ bool InitializeBoard(const Configuration& configuration,
   return true;
 }
 
+// Seeds the generator afresh for every game, so that the journal can say which seed each game was
+// played with and a run started from the same master seed deals the same games.
+std::uint64_t StartGameSeed(RandomPlacementGenerator& placement_generator) {
+  const std::uint64_t seed = MixSeed(master_seed, games_started++);
+
+  placement_generator.Seed(seed);
+
+  return seed;
+}
+
+void BeginJournalGame(const Configuration& configuration,
+                      const std::uint64_t seed,
+                      const FireMode fire_mode,
+                      const Board& board_1,
+                      const Board& board_2) {
+  if (game_journal.has_value()) {
+    game_recorder.Begin(configuration, seed, random_engine, fire_mode, board_1, board_2);
+  }
+}
+
+void RecordJournalShot(const Board& target_board, const Location location) {
+  game_recorder.RecordShot(target_board, location);
+}
+
+// Set from the SIGUSR1 handler, and reported from the game loop at the start of the next turn.
+volatile std::sig_atomic_t is_profile_report_requested = 0;
+
+void RequestProfileReport(const int) {
+  is_profile_report_requested = 1;
+}
+
+// Writes the calls and latencies counted so far to stderr, out of the way of the game's screen.
+void ReportProfile() {
+  if (profiling_enabled) {
+    std::cerr << FormatProfileReport(MergeProfiles()) << std::flush;
+  }
+}
+
+void ReportProfileIfRequested() {
+  if (is_profile_report_requested != 0) {
+    is_profile_report_requested = 0;
+    ReportProfile();
+  }
+}
+
+// Rewrites the trace file with every span so far, so that it can be opened after any game.
+void WriteTrace() {
+  if (trace_path != nullptr) {
+    WriteChromeTrace(trace_path);
+  }
+}
+
+void FinishGame(const int winner) {
+  if (game_recorder.IsRecording()) {
+    game_recorder.Finish(winner);
+    game_journal->Append(game_recorder.GetRecord());
+  }
+
+  ReportProfile();
+  WriteTrace();
+}
+
 void PressEnterToContinue() {
   Print("Press enter to continue. ");
   GetLine();
 }
 
-enum FireMode {
-  NORMAL,
-  SALVO,
-  HIDDEN_MINES
-};
+// Clears the screen for a turn and shows the shooter's board and what they know of the other.
+void PrintTurnBoards(const std::string_view name,
+                     const std::string_view own_board_title,
+                     BoardRenderer& own_board_renderer,
+                     const std::string_view opponent_board_title,
+                     BoardRenderer& opponent_board_renderer) {
+  ClearScreen();
+  Print("It's ");
+  Print(name);
+  PrintLine("'s turn.");
+  PrintLine();
+  PrintLine(own_board_title);
+  own_board_renderer.SetMode(SELF);
+  PrintLine(own_board_renderer.Render());
+  PrintLine(opponent_board_title);
+  opponent_board_renderer.SetMode(TARGET);
+  PrintLine(opponent_board_renderer.Render());
+}
+
+void RecordJournalVolley(const Board& target_board,
+                         const std::vector<Location>& volley,
+                         const std::vector<ShotOutcome>& outcomes) {
+  for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+    if (outcomes[shot] != ShotOutcome::Rejected) {
+      RecordJournalShot(target_board, volley[shot]);
+    }
+  }
+}
+
+bool IsInVolley(const std::vector<Location>& volley, const Location location) {
+  return std::find(volley.begin(), volley.end(), location) != volley.end();
+}
 
+// Salvo turns choose all of their shots first and then fire them together, so the boards are only
+// updated and drawn once per turn.
 bool UserTurn(const std::string_view name,
               const Configuration& configuration,
               RandomPlacementGenerator& placement_generator,
@@ -474,90 +601,93 @@ bool UserTurn(const std::string_view name,
               Board& opponent_board,
               BoardRenderer& opponent_board_renderer,
               const FireMode fire_mode) {
+  TRACE_SPAN("UserTurn");
+  ReportProfileIfRequested();
+
   int shots = 1;
 
   if  (fire_mode == SALVO)  {
-    shots = user_board.GetRemainingShips().size();
+    shots = std::min(user_board.RemainingShipsCount(), opponent_board.NotFiredCount());
   }
 
-  for (int shot = 1; shot <= shots; ++shot) {
-    while (true) {
-      ClearScreen();
-      Print("It's ");
-      Print(name);
-      PrintLine("'s turn.");
-      PrintLine();
-      PrintLine("Your board:");
-      user_board_renderer.SetMode(SELF);
-      PrintLine(user_board_renderer.Render());
-      PrintLine("Your opponent's board:");
-      opponent_board_renderer.SetMode(TARGET);
-      PrintLine(opponent_board_renderer.Render());
-
-      if (shots == 1) {
-        PrintLine("Please choose:");
-      } else {
-        Print("Please choose (shot ");
-        Print(shot);
-        Print(" / ");
-        Print(shots);
-        PrintLine("):");
-      }
-      PrintLine("(1) Fire at chosen location");
-      PrintLine("(2) Fire at a random location");
-      PrintLine();
-      PrintLine("(0) Quit");
-      Print("[1]: ");
+  std::vector<Location> volley;
 
-      std::string choice = GetLine();
-      Location fire_location;
+  PrintTurnBoards(name, "Your board:", user_board_renderer, "Your opponent's board:",
+                  opponent_board_renderer);
 
-      if (choice != "0" && choice != "1" && choice != "2") {
-        choice = "1";
-      }
+  while (static_cast<int>(volley.size()) < shots) {
+    if (shots == 1) {
+      PrintLine("Please choose:");
+    } else {
+      Print("Please choose (shot ");
+      Print(volley.size() + 1);
+      Print(" / ");
+      Print(shots);
+      PrintLine("):");
+    }
+    PrintLine("(1) Fire at chosen location");
+    PrintLine("(2) Fire at a random location");
+    PrintLine();
+    PrintLine("(0) Quit");
+    Print("[1]: ");
 
-      if (choice == "1") {
-        const auto location = ChooseLocation(configuration);
+    std::string choice = GetLine();
+    Location fire_location;
 
-        if (location.has_value()) {
-          fire_location = location.value();
-        }
-      } else if (choice == "2") {
-        fire_location = placement_generator.ChooseLocation(opponent_board.NotFiredLocations());
-      } else {
-        return false;
-      }
+    if (choice != "0" && choice != "1" && choice != "2") {
+      choice = "1";
+    }
 
-      if (opponent_board.Shoot(fire_location)) {
-        ClearScreen();
-        Print("It's ");
-        Print(name);
-        PrintLine("'s turn.");
-        PrintLine();
-        PrintLine("Your board:");
-        user_board_renderer.SetMode(SELF);
-        PrintLine(user_board_renderer.Render());
-        PrintLine("Your opponent's board:");
-        opponent_board_renderer.SetMode(TARGET);
-        PrintLine(opponent_board_renderer.Render());
-        Print("You shot at ");
-        Print(fire_location.ToString());
-        PrintLine(".");
-        if (opponent_board.IsMine(fire_location)) {
-          PrintLine("You hit a mine!");
-        } else if (opponent_board.IsHit(fire_location)) {
-          PrintLine("You scored a hit! Well done!");
-        } else {
-          PrintLine("You missed. Better luck next time!");
-        }
-        PressEnterToContinue();
-        break;
-      } else {
-        PrintLine("Invalid shot. Try again.");
+    if (choice == "1") {
+      const auto location = ChooseLocation(configuration);
+
+      if (location.has_value()) {
+        fire_location = location.value();
       }
+    } else if (choice == "2") {
+      do {
+        fire_location = placement_generator.ChooseNotFiredLocation(opponent_board);
+      } while (IsInVolley(volley, fire_location));
+    } else {
+      return false;
+    }
+
+    if (opponent_board.IsWithinBounds(fire_location) &&
+        !opponent_board.HasShot(fire_location) &&
+        !IsInVolley(volley, fire_location)) {
+      volley.push_back(fire_location);
+    } else {
+      PrintLine("Invalid shot. Try again.");
     }
   }
 
+  const std::vector<ShotOutcome> outcomes = opponent_board.ShootMany(volley);
+  RecordJournalVolley(opponent_board, volley, outcomes);
+  PrintTurnBoards(name, "Your board:", user_board_renderer, "Your opponent's board:",
+                  opponent_board_renderer);
+
+  for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+    if (outcomes[shot] == ShotOutcome::Rejected) {
+      continue;
+    }
+
+    Print("You shot at ");
+    Print(volley[shot].ToString());
+    PrintLine(".");
+
+    if (outcomes[shot] == ShotOutcome::Mine) {
+      PrintLine("You hit a mine!");
+    } else if (outcomes[shot] == ShotOutcome::Sunk) {
+      PrintLine("You sank a ship! Well done!");
+    } else if (outcomes[shot] == ShotOutcome::Hit) {
+      PrintLine("You scored a hit! Well done!");
+    } else {
+      PrintLine("You missed. Better luck next time!");
+    }
+  }
+
+  PressEnterToContinue();
+
   return true;
 }
 
@@ -569,48 +699,49 @@ void ComputerTurn(const std::string_view name,
                   Board& opponent_board,
                   BoardRenderer& opponent_board_renderer,
                   const FireMode fire_mode = NORMAL) {
+  TRACE_SPAN("ComputerTurn");
+  ReportProfileIfRequested();
+
   int shots = 1;
 
   if (fire_mode == SALVO) {
-    shots = computer_board.GetRemainingShips().size();
+    shots = computer_board.RemainingShipsCount();
   }
 
-  for (int shot = 0; shot < shots; ++shot) {
-    const Location fire_location = computer_ai.ChooseNextShot();
+  const std::vector<Location> volley = computer_ai.ChooseVolley(shots);
+  const std::vector<ShotOutcome> outcomes = opponent_board.ShootMany(volley);
+  RecordJournalVolley(opponent_board, volley, outcomes);
+  PrintTurnBoards(name, "The computer's board:", computer_board_renderer,
+                  "The computer's opponent board:", opponent_board_renderer);
 
-    if (opponent_board.Shoot(fire_location)) {
-      ClearScreen();
-      Print("It's ");
-      Print(name);
-      PrintLine("'s turn.");
-      PrintLine();
-      PrintLine("The computer's board:");
-      computer_board_renderer.SetMode(SELF);
-      PrintLine(computer_board_renderer.Render());
-      PrintLine("The computer's opponent board:");
-      opponent_board_renderer.SetMode(TARGET);
-      PrintLine(opponent_board_renderer.Render());
-      Print("The computer shot at ");
-      Print(fire_location.ToString());
-      PrintLine(".");
-
-      if (opponent_board.IsMine(fire_location)) {
-        PrintLine("The computer hit a mine!");
-      } else if (opponent_board.IsHit(fire_location)) {
-        PrintLine("The computer hit the opponent!");
-      } else {
-        PrintLine("The computer missed. Whew!");
-      }
+  for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+    if (outcomes[shot] == ShotOutcome::Rejected) {
+      continue;
     }
 
-    PressEnterToContinue();
+    Print("The computer shot at ");
+    Print(volley[shot].ToString());
+    PrintLine(".");
+
+    if (outcomes[shot] == ShotOutcome::Mine) {
+      PrintLine("The computer hit a mine!");
+    } else if (outcomes[shot] == ShotOutcome::Sunk) {
+      PrintLine("The computer sank a ship!");
+    } else if (outcomes[shot] == ShotOutcome::Hit) {
+      PrintLine("The computer hit the opponent!");
+    } else {
+      PrintLine("The computer missed. Whew!");
+    }
   }
+
+  PressEnterToContinue();
 }
 
 bool UserVsComputer(const Configuration& configuration,
                     RandomPlacementGenerator& placement_generator,
                     const FireMode fire_mode = NORMAL) {
-  Board user_board(configuration.board_width, configuration.board_height);
+  const std::uint64_t seed = StartGameSeed(placement_generator);
+  Board user_board(configuration.board_width, configuration.board_height, fleet_registry);
   BoardRenderer user_board_renderer(user_board);
   PrintBoard(user_board_renderer);
   PrintLine();
@@ -628,18 +759,21 @@ bool UserVsComputer(const Configuration& configuration,
     return false;
   }
 
-  Board computer_board(configuration.board_width, configuration.board_height);
+  Board computer_board(configuration.board_width, configuration.board_height, fleet_registry);
   {
     AutoPlacer computer_auto_placer(computer_board, placement_generator);
     computer_auto_placer.AutoPlace(configuration.ship_types);
   }
   BoardRenderer computer_board_renderer(computer_board);
   ComputerAi computer_ai(user_board, placement_generator);
+  computer_ai.SetTargetingMode(targeting_mode);
 
   if (fire_mode == HIDDEN_MINES) {
     computer_board.AddRandomMines(placement_generator);
   }
 
+  BeginJournalGame(configuration, seed, fire_mode, user_board, computer_board);
+
   while (true) {
     success = UserTurn("the player", configuration, placement_generator,
                        user_board, user_board_renderer,
@@ -647,10 +781,12 @@ bool UserVsComputer(const Configuration& configuration,
                        fire_mode);
 
     if (!success) {
+      FinishGame(0);
       return false;
     }
 
     if (computer_board.AreAllShipsSunk()) {
+      FinishGame(1);
       PrintLine("The player won!");
       break;
     }
@@ -661,6 +797,7 @@ bool UserVsComputer(const Configuration& configuration,
                  fire_mode);
 
     if (user_board.AreAllShipsSunk()) {
+      FinishGame(2);
       PrintLine("The computer won!");
       break;
     }
@@ -674,7 +811,8 @@ bool UserVsComputer(const Configuration& configuration,
 bool UserVsUser(const Configuration& configuration,
                 RandomPlacementGenerator& placement_generator,
                 const FireMode fire_mode = NORMAL) {
-  Board user_1_board(configuration.board_width, configuration.board_height);
+  const std::uint64_t seed = StartGameSeed(placement_generator);
+  Board user_1_board(configuration.board_width, configuration.board_height, fleet_registry);
   BoardRenderer user_1_board_renderer(user_1_board);
   PrintBoard(user_1_board_renderer);
   PrintLine();
@@ -692,7 +830,7 @@ bool UserVsUser(const Configuration& configuration,
     return false;
   }
 
-  Board user_2_board(configuration.board_width, configuration.board_height);
+  Board user_2_board(configuration.board_width, configuration.board_height, fleet_registry);
   BoardRenderer user_2_board_renderer(user_2_board);
   PrintBoard(user_2_board_renderer);
   PrintLine();
@@ -710,6 +848,8 @@ bool UserVsUser(const Configuration& configuration,
     return false;
   }
 
+  BeginJournalGame(configuration, seed, fire_mode, user_1_board, user_2_board);
+
   while (true) {
     success = UserTurn("player 1", configuration, placement_generator,
                        user_1_board, user_1_board_renderer,
@@ -717,10 +857,12 @@ bool UserVsUser(const Configuration& configuration,
                        fire_mode);
 
     if (!success) {
+      FinishGame(0);
       return false;
     }
 
     if (user_2_board.AreAllShipsSunk()) {
+      FinishGame(1);
       PrintLine("Player 1 won!");
       break;
     }
@@ -731,10 +873,12 @@ bool UserVsUser(const Configuration& configuration,
                        fire_mode);
 
     if (!success) {
+      FinishGame(0);
       return false;
     }
 
     if (user_1_board.AreAllShipsSunk()) {
+      FinishGame(2);
       PrintLine("Player 2 won!");
       break;
     }
@@ -747,11 +891,12 @@ bool UserVsUser(const Configuration& configuration,
 
 void ComputerVsComputerHiddenMines(const Configuration& configuration,
                                    RandomPlacementGenerator& placement_generator) {
-  Board computer_1_board(configuration.board_width, configuration.board_height);
+  const std::uint64_t seed = StartGameSeed(placement_generator);
+  Board computer_1_board(configuration.board_width, configuration.board_height, fleet_registry);
   computer_1_board.AddRandomMines(placement_generator);
   BoardRenderer computer_1_board_renderer(computer_1_board);
 
-  Board computer_2_board(configuration.board_width, configuration.board_height);
+  Board computer_2_board(configuration.board_width, configuration.board_height, fleet_registry);
   computer_2_board.AddRandomMines(placement_generator);
   BoardRenderer computer_2_board_renderer(computer_2_board);
 
@@ -764,6 +909,10 @@ void ComputerVsComputerHiddenMines(const Configuration& configuration,
 
   ComputerAi computer_1_ai(computer_2_board, placement_generator);
   ComputerAi computer_2_ai(computer_1_board, placement_generator);
+  computer_1_ai.SetTargetingMode(targeting_mode);
+  computer_2_ai.SetTargetingMode(targeting_mode);
+
+  BeginJournalGame(configuration, seed, HIDDEN_MINES, computer_1_board, computer_2_board);
 
   while (true) {
     ComputerTurn("computer 1", placement_generator, computer_1_ai,
@@ -772,6 +921,7 @@ void ComputerVsComputerHiddenMines(const Configuration& configuration,
                  NORMAL);
 
     if (computer_2_board.AreAllShipsSunk()) {
+      FinishGame(1);
       PrintLine("Computer 1 won!");
       break;
     }
@@ -782,6 +932,7 @@ void ComputerVsComputerHiddenMines(const Configuration& configuration,
                  NORMAL);
 
     if (computer_1_board.AreAllShipsSunk()) {
+      FinishGame(2);
       PrintLine("Computer 2 won!");
       break;
     }
@@ -790,9 +941,378 @@ void ComputerVsComputerHiddenMines(const Configuration& configuration,
   PressEnterToContinue();
 }
 
-int main() {
-  RandomPlacementGenerator placement_generator;
+SessionServer* running_server = nullptr;
+
+void StopServer(const int) {
+  if (running_server != nullptr) {
+    running_server->Stop();
+  }
+}
+
+// Serves games over a Unix domain socket until interrupted, instead of playing one on the terminal.
+int Serve(const Configuration& configuration, const char* const socket_path,
+          const int worker_count) {
+  SessionServer server(configuration, socket_path, worker_count, master_seed, random_engine);
+
+  if (!server.Listen()) {
+    PrintLine("Could not listen on the socket.");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  running_server = &server;
+  std::signal(SIGINT, StopServer);
+  std::signal(SIGTERM, StopServer);
+
+  Print("Serving games on ");
+  Print(socket_path);
+  Print(" with ");
+  Print(server.GetWorkerCount());
+  PrintLine(" workers.");
+  terminal_output.Flush();
+
+  server.Run();
+  running_server = nullptr;
+  ReportProfile();
+
+  return 0;
+}
+
+const char* ShotResultText(const ShotResult shot_result) {
+  if (shot_result == ShotResult::Mine) {
+    return "a mine";
+  } else if (shot_result == ShotResult::Hit) {
+    return "a hit";
+  }
+
+  return "a miss";
+}
+
+// Steps through a journaled game by firing its shots at boards set up the way they were.
+int Replay(const Configuration& configuration, const char* const journal_path,
+           const int game_number) {
+  const JournalReader journal_reader(journal_path);
+
+  if (!journal_reader.IsOpen() || (journal_reader.GetGameCount() == 0)) {
+    PrintLine("Could not read any games from the journal.");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  const int game = (game_number == 0) ? journal_reader.GetGameCount() : game_number;
+  GameRecord record;
+
+  if (!journal_reader.ReadGame(game - 1, configuration.ship_types.size(), record)) {
+    PrintLine("The journal has no such game.");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  if (record.summary.configuration_hash != ConfigurationHash(configuration)) {
+    PrintLine("The game was played with a different configuration.");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  std::array<Board, 2> boards{ Board(record.summary.width, record.summary.height, fleet_registry),
+                               Board(record.summary.width, record.summary.height, fleet_registry) };
+
+  for (int board = 0; board < 2; ++board) {
+    for (const JournalBoat& boat : record.boats[board]) {
+      boards[board].AddBoat(configuration.ship_types[boat.ship_type], boat.start_location,
+                            boat.orientation);
+    }
+
+    for (const Location mine : record.mines[board]) {
+      boards[board].AddMine(mine);
+    }
+  }
+
+  const BoardRenderer board_1_renderer(boards[0]);
+  const BoardRenderer board_2_renderer(boards[1]);
+
+  for (int shot = 0; shot < static_cast<int>(record.shots.size()); ++shot) {
+    const JournalShot& journal_shot = record.shots[shot];
+    Board& target_board = boards[journal_shot.board];
+
+    target_board.Shoot(journal_shot.location);
+
+    ClearScreen();
+    Print("Game ");
+    Print(game);
+    Print(", shot ");
+    Print(shot + 1);
+    Print(" / ");
+    Print(record.shots.size());
+    PrintLine();
+    PrintLine();
+    PrintLine("Player 1's board:");
+    PrintLine(board_1_renderer.Render());
+    PrintLine("Player 2's board:");
+    PrintLine(board_2_renderer.Render());
+    Print("Player ");
+    Print(2 - journal_shot.board);
+    Print(" shot at ");
+    Print(journal_shot.location.ToString());
+    Print(", ");
+    Print(ShotResultText(journal_shot.result));
+    PrintLine(".");
+
+    if (RecordedShotResult(target_board, journal_shot.location) != journal_shot.result) {
+      PrintLine("This shot doesn't match the journal.");
+    }
+
+    PressEnterToContinue();
+  }
+
+  if (record.summary.winner == 0) {
+    PrintLine("The game was quit before it ended.");
+  } else {
+    Print("Player ");
+    Print(record.summary.winner);
+    PrintLine(" won!");
+  }
+
+  terminal_output.Flush();
+
+  return 0;
+}
+
+struct CommandLine {
+  const char* serve_path = nullptr;
+  // 0 uses one worker per hardware thread.
+  int worker_count = 0;
+  const char* journal_path = nullptr;
+  const char* replay_path = nullptr;
+  // Counting from 1, or 0 for the journal's last game.
+  int replay_game = 0;
+  std::optional<std::uint64_t> seed;
+  std::optional<RandomEngine> random_engine;
+  const char* trace_path = nullptr;
+  std::optional<TargetingMode> targeting_mode;
+};
+
+// Whole numbers of up to nineteen digits, so that they always fit in a std::uint64_t.
+std::optional<std::uint64_t> ParseSeedNumber(const std::string_view text) {
+  constexpr static int max_digits = 19;
+
+  if (text.empty() || (text.size() > max_digits)) {
+    return std::nullopt;
+  }
+
+  std::uint64_t value = 0;
+
+  for (const char character : text) {
+    if ((character < '0') || (character > '9')) {
+      return std::nullopt;
+    }
+
+    value = (10 * value) + (character - '0');
+  }
+
+  return value;
+}
+
+std::optional<RandomEngine> ParseRandomEngine(const std::string_view text) {
+  if (text == "mt19937") {
+    return RandomEngine::MersenneTwister;
+  }
+
+  if (text == "philox") {
+    return RandomEngine::Philox;
+  }
+
+  return std::nullopt;
+}
+
+std::optional<TargetingMode> ParseTargetingMode(const std::string_view text) {
+  if (text == "random") {
+    return TargetingMode::Random;
+  }
+
+  if (text == "density") {
+    return TargetingMode::ProbabilityDensity;
+  }
+
+  if (text == "montecarlo") {
+    return TargetingMode::MonteCarlo;
+  }
+
+  if (text == "parity") {
+    return TargetingMode::Parity;
+  }
+
+  return std::nullopt;
+}
+
+// Takes the number following the option at index, if there is one.
+bool TakeOptionalNumber(const int argc, char* argv[], int& index, int& number) {
+  if ((index + 1 >= argc) || (std::string_view(argv[index + 1]).substr(0, 2) == "--")) {
+    return true;
+  }
+
+  const std::optional<int> value = ParseChoiceNumber(argv[++index]);
+
+  if (!value.has_value()) {
+    return false;
+  }
+
+  number = *value;
+
+  return true;
+}
+
+//   --serve <socket path> [worker count]   serves games over a Unix domain socket
+//   --journal <path>                       appends every game played to a journal
+//   --replay <path> [game number]          steps through a journaled game
+//   --seed <number>                        seeds every game, so that a run can be repeated
+//   --random-engine mt19937|philox         picks the engine the seed drives
+//   --trace <path>                         writes a Chrome trace of the game loop after each game
+//   --targeting random|density|montecarlo|parity
+//                                          picks how the computer aims in terminal games; served
+//                                          games pick it with NEW
+std::optional<CommandLine> ParseCommandLine(const int argc, char* argv[]) {
+  CommandLine command_line;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view option = argv[index];
+    const bool has_value = index + 1 < argc;
+
+    if ((option == "--serve") && has_value) {
+      command_line.serve_path = argv[++index];
+
+      if (!TakeOptionalNumber(argc, argv, index, command_line.worker_count)) {
+        return std::nullopt;
+      }
+    } else if ((option == "--journal") && has_value) {
+      command_line.journal_path = argv[++index];
+    } else if ((option == "--replay") && has_value) {
+      command_line.replay_path = argv[++index];
+
+      if (!TakeOptionalNumber(argc, argv, index, command_line.replay_game)) {
+        return std::nullopt;
+      }
+    } else if ((option == "--seed") && has_value) {
+      command_line.seed = ParseSeedNumber(argv[++index]);
+
+      if (!command_line.seed.has_value()) {
+        return std::nullopt;
+      }
+    } else if ((option == "--trace") && has_value) {
+      command_line.trace_path = argv[++index];
+    } else if ((option == "--random-engine") && has_value) {
+      command_line.random_engine = ParseRandomEngine(argv[++index]);
+
+      if (!command_line.random_engine.has_value()) {
+        return std::nullopt;
+      }
+    } else if ((option == "--targeting") && has_value) {
+      command_line.targeting_mode = ParseTargetingMode(argv[++index]);
+
+      if (!command_line.targeting_mode.has_value()) {
+        return std::nullopt;
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  return command_line;
+}
+
+// Sets the master seed from, in order, --seed, the ADASHIP_SEED environment variable, the
+// configuration's seed and otherwise std::random_device, and the engine from --random-engine, then
+// ADASHIP_RANDOM_ENGINE, defaulting to the Mersenne Twister. False if an environment variable
+// can't be read.
+bool ChooseRandomness(const CommandLine& command_line, const Configuration& configuration) {
+  std::optional<std::uint64_t> seed = command_line.seed;
+
+  if (const char* const seed_text = std::getenv("ADASHIP_SEED");
+      !seed.has_value() && (seed_text != nullptr)) {
+    seed = ParseSeedNumber(seed_text);
+
+    if (!seed.has_value()) {
+      return false;
+    }
+  }
+
+  if (!seed.has_value()) {
+    seed = configuration.seed;
+  }
+
+  if (!seed.has_value()) {
+    std::random_device random_device;
+    seed = (static_cast<std::uint64_t>(random_device()) << 32) | random_device();
+  }
+
+  std::optional<RandomEngine> engine = command_line.random_engine;
+
+  if (const char* const engine_text = std::getenv("ADASHIP_RANDOM_ENGINE");
+      !engine.has_value() && (engine_text != nullptr)) {
+    engine = ParseRandomEngine(engine_text);
+
+    if (!engine.has_value()) {
+      return false;
+    }
+  }
+
+  master_seed = *seed;
+  random_engine = engine.value_or(RandomEngine::MersenneTwister);
+
+  return true;
+}
+
+int main(const int argc, char* argv[]) {
+  const std::optional<CommandLine> command_line = ParseCommandLine(argc, argv);
+
+  if (!command_line.has_value()) {
+    PrintLine("Usage: [--journal <path>] [--serve <socket path> [worker count]] "
+              "[--replay <journal path> [game number]] [--seed <number>] "
+              "[--random-engine mt19937|philox] [--trace <path>] "
+              "[--targeting random|density|montecarlo|parity]");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  targeting_mode = command_line->targeting_mode.value_or(TargetingMode::Random);
+
+  if (command_line->trace_path != nullptr) {
+    trace_path = command_line->trace_path;
+    StartTracing();
+  }
+
   Configuration configuration = ReadConfiguration();
+  fleet_registry = FleetRegistry(configuration.ship_types);
+
+  if (!ChooseRandomness(*command_line, configuration)) {
+    PrintLine("ADASHIP_SEED must be a whole number and ADASHIP_RANDOM_ENGINE mt19937 or philox.");
+    terminal_output.Flush();
+    return 1;
+  }
+
+  RandomPlacementGenerator placement_generator(master_seed, random_engine);
+
+  if (command_line->replay_path != nullptr) {
+    return Replay(configuration, command_line->replay_path, command_line->replay_game);
+  }
+
+  if (command_line->serve_path != nullptr) {
+    return Serve(configuration, command_line->serve_path, command_line->worker_count);
+  }
+
+  if (profiling_enabled) {
+    std::signal(SIGUSR1, RequestProfileReport);
+  }
+
+  if (command_line->journal_path != nullptr) {
+    game_journal.emplace(command_line->journal_path);
+
+    if (!game_journal->IsOpen()) {
+      PrintLine("Could not open the journal.");
+      terminal_output.Flush();
+      return 1;
+    }
+  }
 
   while (true) {
     ClearScreen();
@@ -825,6 +1345,7 @@ int main() {
     } else if (game_choice == "7") {
       ComputerVsComputerHiddenMines(configuration, placement_generator);
     } else {
+      WriteTrace();
       return 0;
     }
   }
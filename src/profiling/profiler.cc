@@ -0,0 +1,191 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+struct AtomicTotals {
+  std::atomic<std::uint64_t> calls{ 0 };
+  std::atomic<std::uint64_t> total_nanoseconds{ 0 };
+  std::atomic<std::uint64_t> max_nanoseconds{ 0 };
+  std::array<std::atomic<std::uint64_t>, profile_histogram_buckets> histogram{};
+};
+
+struct ThreadProfile;
+
+// Every live thread's counters, and the sums of those of the threads that have exited.
+struct ProfileRegistry {
+  std::mutex mutex;
+  std::vector<ThreadProfile*> threads;
+  ProfileReport retired{};
+};
+
+ProfileRegistry& GetProfileRegistry() {
+  // Never destroyed, so that threads exiting after main returns can still retire their counts.
+  static ProfileRegistry* const registry = new ProfileRegistry();
+  return *registry;
+}
+
+void AddToTotals(const AtomicTotals& source, ProfileTotals& totals) {
+  totals.calls += source.calls.load(std::memory_order_relaxed);
+  totals.total_nanoseconds += source.total_nanoseconds.load(std::memory_order_relaxed);
+  totals.max_nanoseconds =
+      std::max(totals.max_nanoseconds, source.max_nanoseconds.load(std::memory_order_relaxed));
+
+  for (int bucket = 0; bucket < profile_histogram_buckets; ++bucket) {
+    totals.histogram[bucket] += source.histogram[bucket].load(std::memory_order_relaxed);
+  }
+}
+
+struct ThreadProfile {
+  ThreadProfile() {
+    ProfileRegistry& registry = GetProfileRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(this);
+  }
+
+  ~ThreadProfile() {
+    ProfileRegistry& registry = GetProfileRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (int point = 0; point < profile_point_count; ++point) {
+      AddToTotals(points[point], registry.retired[point]);
+    }
+
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+  }
+
+  std::array<AtomicTotals, profile_point_count> points;
+};
+
+// Only the owning thread writes, so a relaxed load and store is enough to add.
+void AddRelaxed(std::atomic<std::uint64_t>& counter, const std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+int HistogramBucket(std::uint64_t nanoseconds) {
+  int bucket = 0;
+
+  while ((nanoseconds != 0) && (bucket < profile_histogram_buckets - 1)) {
+    nanoseconds >>= 1;
+    ++bucket;
+  }
+
+  return bucket;
+}
+
+std::uint64_t BucketUpperBound(const int bucket) {
+  return (std::uint64_t(1) << bucket) - 1;
+}
+
+std::uint64_t ProfileTotals::Percentile(const double fraction) const {
+  const std::uint64_t rank = static_cast<std::uint64_t>(fraction * calls);
+  std::uint64_t seen = 0;
+
+  for (int bucket = 0; bucket < profile_histogram_buckets; ++bucket) {
+    seen += histogram[bucket];
+
+    if ((seen > rank) || (seen == calls)) {
+      return std::min(BucketUpperBound(bucket), max_nanoseconds);
+    }
+  }
+
+  return max_nanoseconds;
+}
+
+const char* ProfilePointName(const ProfilePoint point) {
+  switch (point) {
+    case ProfilePoint::BoardShoot:
+      return "Board::Shoot";
+    case ProfilePoint::BoardShootMany:
+      return "Board::ShootMany";
+    case ProfilePoint::BoardNotFiredLocations:
+      return "Board::NotFiredLocations";
+    case ProfilePoint::BoardGetRemainingShips:
+      return "Board::GetRemainingShips";
+    case ProfilePoint::ComputerAiChooseNextShot:
+      return "ComputerAi::ChooseNextShot";
+    case ProfilePoint::AutoPlacerAutoPlace:
+      return "AutoPlacer::AutoPlace";
+    case ProfilePoint::BoardRendererRender:
+      return "BoardRenderer::Render";
+    default:
+      return "?";
+  }
+}
+
+void RecordProfileSample(const ProfilePoint point, const std::uint64_t nanoseconds) {
+  thread_local ThreadProfile thread_profile;
+  AtomicTotals& totals = thread_profile.points[static_cast<int>(point)];
+
+  AddRelaxed(totals.calls, 1);
+  AddRelaxed(totals.total_nanoseconds, nanoseconds);
+  AddRelaxed(totals.histogram[HistogramBucket(nanoseconds)], 1);
+
+  if (nanoseconds > totals.max_nanoseconds.load(std::memory_order_relaxed)) {
+    totals.max_nanoseconds.store(nanoseconds, std::memory_order_relaxed);
+  }
+}
+
+ProfileReport MergeProfiles() {
+  ProfileRegistry& registry = GetProfileRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  ProfileReport report = registry.retired;
+
+  for (const ThreadProfile* const thread_profile : registry.threads) {
+    for (int point = 0; point < profile_point_count; ++point) {
+      AddToTotals(thread_profile->points[point], report[point]);
+    }
+  }
+
+  return report;
+}
+
+void ResetProfiles() {
+  ProfileRegistry& registry = GetProfileRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.retired = ProfileReport();
+
+  for (ThreadProfile* const thread_profile : registry.threads) {
+    for (AtomicTotals& totals : thread_profile->points) {
+      totals.calls.store(0, std::memory_order_relaxed);
+      totals.total_nanoseconds.store(0, std::memory_order_relaxed);
+      totals.max_nanoseconds.store(0, std::memory_order_relaxed);
+
+      for (std::atomic<std::uint64_t>& bucket : totals.histogram) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+std::string FormatProfileReport(const ProfileReport& report) {
+  std::string text;
+  char line[160];
+
+  std::snprintf(line, sizeof(line), "%-28s %10s %12s %10s %10s %10s %10s %10s\n", "function",
+                "calls", "total ms", "mean ns", "p50 ns", "p90 ns", "p99 ns", "max ns");
+  text += line;
+
+  for (int point = 0; point < profile_point_count; ++point) {
+    const ProfileTotals& totals = report[point];
+
+    if (totals.calls == 0) {
+      continue;
+    }
+
+    std::snprintf(line, sizeof(line), "%-28s %10llu %12.3f %10llu %10llu %10llu %10llu %10llu\n",
+                  ProfilePointName(static_cast<ProfilePoint>(point)),
+                  static_cast<unsigned long long>(totals.calls),
+                  totals.total_nanoseconds / 1e6,
+                  static_cast<unsigned long long>(totals.total_nanoseconds / totals.calls),
+                  static_cast<unsigned long long>(totals.Percentile(0.5)),
+                  static_cast<unsigned long long>(totals.Percentile(0.9)),
+                  static_cast<unsigned long long>(totals.Percentile(0.99)),
+                  static_cast<unsigned long long>(totals.max_nanoseconds));
+    text += line;
+  }
+
+  return text;
+}
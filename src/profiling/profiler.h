@@ -0,0 +1,88 @@
+#ifndef SRC_PROFILING_PROFILER_H
+#define SRC_PROFILING_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// The functions whose calls are counted and timed.
+enum class ProfilePoint {
+  BoardShoot,
+  BoardShootMany,
+  BoardNotFiredLocations,
+  BoardGetRemainingShips,
+  ComputerAiChooseNextShot,
+  AutoPlacerAutoPlace,
+  BoardRendererRender,
+  Count
+};
+
+constexpr int profile_point_count = static_cast<int>(ProfilePoint::Count);
+
+// Call latencies are counted in buckets by the bit width of their duration in nanoseconds, so
+// bucket b holds calls that took from 2^(b - 1) up to 2^b - 1 nanoseconds.
+constexpr int profile_histogram_buckets = 48;
+
+#ifdef ADASHIP_PROFILING
+constexpr bool profiling_enabled = true;
+#else
+constexpr bool profiling_enabled = false;
+#endif
+
+// The merged counts for one profile point.
+struct ProfileTotals {
+  std::uint64_t calls = 0;
+  std::uint64_t total_nanoseconds = 0;
+  std::uint64_t max_nanoseconds = 0;
+  std::array<std::uint64_t, profile_histogram_buckets> histogram{};
+
+  // The upper bound of the bucket holding the given fraction of calls, in nanoseconds.
+  std::uint64_t Percentile(const double fraction) const;
+};
+
+using ProfileReport = std::array<ProfileTotals, profile_point_count>;
+
+const char* ProfilePointName(const ProfilePoint point);
+
+// Adds one call that took the given time to the calling thread's counters. Each thread only ever
+// writes its own counters, so there is no locking or read-modify-write on this path, and the
+// counters are only atomic so that another thread can read them while they change.
+void RecordProfileSample(const ProfilePoint point, const std::uint64_t nanoseconds);
+
+// Sums the counters of every thread, including threads that have since exited.
+ProfileReport MergeProfiles();
+// Zeroes every thread's counters. Counts recorded while this runs may be lost.
+void ResetProfiles();
+// A table of calls, total time, mean, percentiles and maximum for every point that was called.
+std::string FormatProfileReport(const ProfileReport& report);
+
+// Counts and times the enclosing scope.
+class ProfileScope {
+public:
+  explicit ProfileScope(const ProfilePoint point)
+    : point(point), start(std::chrono::steady_clock::now()) {}
+
+  ~ProfileScope() {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    RecordProfileSample(point,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  ProfilePoint point;
+  std::chrono::steady_clock::time_point start;
+};
+
+// Only builds configured with ADASHIP_PROFILING pay for the timing.
+#ifdef ADASHIP_PROFILING
+#define PROFILE_SCOPE(point) const ProfileScope profile_scope(point)
+#else
+#define PROFILE_SCOPE(point) static_cast<void>(0)
+#endif
+
+#endif // SRC_PROFILING_PROFILER_H
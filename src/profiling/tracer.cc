@@ -0,0 +1,172 @@
+#include "tracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// The fields are relaxed atomics so that a flush on another thread can read a slot while its
+// owner overwrites it; the flush then notices from the ring's count and leaves the slot out.
+struct TraceSlot {
+  std::atomic<const char*> name{ nullptr };
+  std::atomic<std::uint64_t> start_nanoseconds{ 0 };
+  std::atomic<std::uint64_t> duration_nanoseconds{ 0 };
+};
+
+struct TraceEvent {
+  const char* name;
+  std::uint64_t start_nanoseconds;
+  std::uint64_t duration_nanoseconds;
+};
+
+struct TraceRing {
+  explicit TraceRing(const int thread_number)
+    : thread_number(thread_number), slots(trace_ring_capacity) {}
+
+  int thread_number;
+  std::vector<TraceSlot> slots;
+  // Spans ever written, so the next one goes in slot written % trace_ring_capacity.
+  std::atomic<std::uint64_t> written{ 0 };
+};
+
+// Rings outlive their threads, so that the spans of threads that have exited can still be written.
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TraceRing>> rings;
+  std::atomic<bool> is_tracing{ false };
+  std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+TraceRegistry& GetTraceRegistry() {
+  static TraceRegistry* const registry = new TraceRegistry();
+  return *registry;
+}
+
+TraceRing& ThreadTraceRing() {
+  thread_local TraceRing* ring = nullptr;
+
+  if (ring == nullptr) {
+    TraceRegistry& registry = GetTraceRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.rings.push_back(std::make_unique<TraceRing>(registry.rings.size() + 1));
+    ring = registry.rings.back().get();
+  }
+
+  return *ring;
+}
+
+void StartTracing() {
+  TraceRegistry& registry = GetTraceRegistry();
+  registry.epoch = std::chrono::steady_clock::now();
+  registry.is_tracing.store(true, std::memory_order_release);
+}
+
+void StopTracing() {
+  GetTraceRegistry().is_tracing.store(false, std::memory_order_release);
+}
+
+bool IsTracing() {
+  return GetTraceRegistry().is_tracing.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TraceNanoseconds() {
+  const auto elapsed = std::chrono::steady_clock::now() - GetTraceRegistry().epoch;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+void RecordTraceSpan(const char* const name,
+                     const std::uint64_t start_nanoseconds,
+                     const std::uint64_t duration_nanoseconds) {
+  TraceRing& ring = ThreadTraceRing();
+  const std::uint64_t written = ring.written.load(std::memory_order_relaxed);
+  TraceSlot& slot = ring.slots[written % trace_ring_capacity];
+
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start_nanoseconds.store(start_nanoseconds, std::memory_order_relaxed);
+  slot.duration_nanoseconds.store(duration_nanoseconds, std::memory_order_relaxed);
+  ring.written.store(written + 1, std::memory_order_release);
+}
+
+void AppendJsonString(std::string& text, const char* name) {
+  text += '"';
+
+  for (; *name != '\0'; ++name) {
+    if ((*name == '"') || (*name == '\\')) {
+      text += '\\';
+    }
+
+    text += *name;
+  }
+
+  text += '"';
+}
+
+void AppendRingEvents(const TraceRing& ring, std::string& text, bool& is_first) {
+  const std::uint64_t written = ring.written.load(std::memory_order_acquire);
+  const std::uint64_t first = written > trace_ring_capacity ? written - trace_ring_capacity : 0;
+  std::vector<TraceEvent> events;
+  events.reserve(written - first);
+
+  for (std::uint64_t index = first; index < written; ++index) {
+    const TraceSlot& slot = ring.slots[index % trace_ring_capacity];
+
+    events.push_back(TraceEvent{ slot.name.load(std::memory_order_relaxed),
+                                 slot.start_nanoseconds.load(std::memory_order_relaxed),
+                                 slot.duration_nanoseconds.load(std::memory_order_relaxed) });
+  }
+
+  // Slots the owner has moved on to since the copy started may be torn.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::uint64_t written_after = ring.written.load(std::memory_order_relaxed);
+  const std::uint64_t first_intact =
+      written_after > trace_ring_capacity ? written_after - trace_ring_capacity + 1 : 0;
+  char numbers[96];
+
+  for (std::uint64_t index = std::max(first, first_intact); index < written; ++index) {
+    const TraceEvent& event = events[index - first];
+
+    text += is_first ? "\n" : ",\n";
+    text += "{\"name\":";
+    AppendJsonString(text, event.name);
+    std::snprintf(numbers, sizeof(numbers), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                  event.start_nanoseconds / 1e3, event.duration_nanoseconds / 1e3);
+    text += numbers;
+    text += ",\"pid\":1,\"tid\":";
+    text += std::to_string(ring.thread_number);
+    text += '}';
+    is_first = false;
+  }
+}
+
+std::string FormatChromeTrace() {
+  TraceRegistry& registry = GetTraceRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  std::string text = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool is_first = true;
+
+  for (const std::unique_ptr<TraceRing>& ring : registry.rings) {
+    AppendRingEvents(*ring, text, is_first);
+  }
+
+  text += "\n]}\n";
+
+  return text;
+}
+
+bool WriteChromeTrace(const std::string& path) {
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output << FormatChromeTrace();
+  return static_cast<bool>(output);
+}
+
+void ClearTrace() {
+  TraceRegistry& registry = GetTraceRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+
+  for (const std::unique_ptr<TraceRing>& ring : registry.rings) {
+    ring->written.store(0, std::memory_order_release);
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef SRC_PROFILING_TRACER_H
+#define SRC_PROFILING_TRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Each thread keeps its latest trace_ring_capacity spans, dropping the oldest ones first. A full
+// ring is written without its oldest span, whose slot is the next to be overwritten.
+constexpr int trace_ring_capacity = 1 << 16;
+
+// Starts recording spans, with timestamps counted from now. Call it before any other thread
+// records spans. Spans recorded before a restart are kept.
+void StartTracing();
+void StopTracing();
+bool IsTracing();
+
+// Nanoseconds since tracing was started.
+std::uint64_t TraceNanoseconds();
+
+// Adds a span to the calling thread's ring. Only the owning thread writes to a ring, so this takes
+// no lock, and name must outlive the trace, which a string literal does.
+void RecordTraceSpan(const char* const name,
+                     const std::uint64_t start_nanoseconds,
+                     const std::uint64_t duration_nanoseconds);
+
+// Every thread's spans in the Chrome trace event format, as complete ("X") events that Perfetto
+// and chrome://tracing can open. Safe to call while other threads are recording; a span being
+// overwritten during the copy is left out.
+std::string FormatChromeTrace();
+// Writes FormatChromeTrace to path, replacing the file. False if it can't be written.
+bool WriteChromeTrace(const std::string& path);
+// Drops every recorded span. Only call it while no other thread is recording.
+void ClearTrace();
+
+// Records the enclosing scope as a span while tracing, and costs one relaxed load otherwise.
+class TraceSpan {
+public:
+  explicit TraceSpan(const char* const name)
+    : name(IsTracing() ? name : nullptr), start(this->name != nullptr ? TraceNanoseconds() : 0) {}
+
+  ~TraceSpan() {
+    if (name != nullptr) {
+      RecordTraceSpan(name, start, TraceNanoseconds() - start);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  const char* name;
+  std::uint64_t start;
+};
+
+// Spans can nest in one scope, so each gets a variable named after its line.
+#define TRACE_SPAN_VARIABLE(line) trace_span_##line
+#define TRACE_SPAN_AT(name, line) const TraceSpan TRACE_SPAN_VARIABLE(line)(name)
+#define TRACE_SPAN(name) TRACE_SPAN_AT(name, __LINE__)
+
+#endif // SRC_PROFILING_TRACER_H
@@ -0,0 +1,389 @@
+#include "game-session.h"
+
+#include "board/auto-placer.h"
+#include "shared.h"
+
+// Takes the next space separated word off the front of text.
+std::string_view TakeWord(std::string_view& text) {
+  while (!text.empty() && (text.front() == ' ')) {
+    text.remove_prefix(1);
+  }
+
+  std::size_t end = 0;
+
+  while ((end < text.size()) && (text[end] != ' ')) {
+    ++end;
+  }
+
+  const std::string_view word = text.substr(0, end);
+  text.remove_prefix(end);
+
+  return word;
+}
+
+bool IsWord(const std::string_view word, const std::string_view lowercase) {
+  if (word.size() != lowercase.size()) {
+    return false;
+  }
+
+  for (int index = 0; index < static_cast<int>(word.size()); ++index) {
+    char character = word[index];
+
+    if ((character >= 'A') && (character <= 'Z')) {
+      character += ('a' - 'A');
+    }
+
+    if (character != lowercase[index]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const char* ShotResultName(const Board& board, const Location location) {
+  if (board.IsMine(location)) {
+    return "MINE";
+  } else if (board.IsHit(location)) {
+    return "HIT";
+  }
+
+  return "MISS";
+}
+
+// The ship's 1-based number, or 0 if text doesn't name one of ship_count ships.
+int ParseShipNumber(const std::string_view text, const int ship_count) {
+  int ship = 0;
+
+  for (const char character : text) {
+    if ((character < '0') || (character > '9')) {
+      return 0;
+    }
+
+    ship = (10 * ship) + (character - '0');
+
+    if (ship > ship_count) {
+      return 0;
+    }
+  }
+
+  return ship;
+}
+
+void AppendLine(std::string& output, const std::string_view line) {
+  output.append(line);
+  output.push_back('\n');
+}
+
+void AppendError(std::string& output, const std::string_view reason) {
+  output.append("ERR ");
+  AppendLine(output, reason);
+}
+
+GameSession::GameSession(const Configuration& configuration)
+  : configuration(configuration), fleet_registry(configuration.ship_types) {
+  game.emplace(configuration, fleet_registry, placement_generator);
+}
+
+GameSession::GameSession(const Configuration& configuration,
+                         const std::uint64_t seed,
+                         const RandomEngine random_engine)
+  : configuration(configuration),
+    fleet_registry(configuration.ship_types),
+    placement_generator(seed, random_engine) {
+  game.emplace(configuration, fleet_registry, placement_generator);
+}
+
+SessionState GameSession::GetState() const {
+  return state;
+}
+
+bool GameSession::IsClosed() const {
+  return is_closed;
+}
+
+std::string GameSession::HandleLine(const std::string_view text) {
+  std::string output;
+  std::string_view line = text;
+
+  if (!line.empty() && (line.back() == '\r')) {
+    line.remove_suffix(1);
+  }
+
+  const std::string_view command = TakeWord(line);
+
+  if (is_closed) {
+    AppendError(output, "session closed");
+  } else if (IsWord(command, "new")) {
+    NewGame(line, output);
+  } else if (IsWord(command, "ships")) {
+    ListShips(output);
+  } else if (IsWord(command, "place")) {
+    PlaceShip(line, output);
+  } else if (IsWord(command, "auto")) {
+    AutoPlaceShips(output);
+  } else if (IsWord(command, "reset")) {
+    ResetShips(output);
+  } else if (IsWord(command, "start")) {
+    StartGame(output);
+  } else if (IsWord(command, "fire")) {
+    Fire(line, output);
+  } else if (IsWord(command, "board")) {
+    RenderBoards(output);
+  } else if (IsWord(command, "quit")) {
+    is_closed = true;
+    AppendLine(output, "OK");
+  } else {
+    AppendError(output, "unknown command");
+  }
+
+  return output;
+}
+
+void GameSession::NewGame(const std::string_view text, std::string& output) {
+  std::string_view arguments = text;
+  const std::string_view mode = TakeWord(arguments);
+
+  if (mode.empty() || IsWord(mode, "normal")) {
+    fire_mode = NORMAL;
+  } else if (IsWord(mode, "salvo")) {
+    fire_mode = SALVO;
+  } else if (IsWord(mode, "mines")) {
+    fire_mode = HIDDEN_MINES;
+  } else {
+    AppendError(output, "unknown mode");
+    return;
+  }
+
+  const std::string_view targeting = TakeWord(arguments);
+
+  if (targeting.empty() || IsWord(targeting, "random")) {
+    targeting_mode = TargetingMode::Random;
+  } else if (IsWord(targeting, "density")) {
+    targeting_mode = TargetingMode::ProbabilityDensity;
+  } else if (IsWord(targeting, "montecarlo")) {
+    targeting_mode = TargetingMode::MonteCarlo;
+  } else if (IsWord(targeting, "parity")) {
+    targeting_mode = TargetingMode::Parity;
+  } else {
+    AppendError(output, "unknown targeting");
+    return;
+  }
+
+  game.reset();
+  game.emplace(configuration, fleet_registry, placement_generator);
+  game->computer_ai.SetTargetingMode(targeting_mode);
+  state = SessionState::Placing;
+  shots_left = 0;
+
+  if (fire_mode == HIDDEN_MINES) {
+    game->player_board.AddRandomMines(placement_generator);
+  }
+
+  AppendLine(output, "OK");
+}
+
+void GameSession::ListShips(std::string& output) const {
+  for (int index = 0; index < static_cast<int>(configuration.ship_types.size()); ++index) {
+    const ShipType& ship_type = configuration.ship_types[index];
+
+    output.append(std::to_string(index + 1));
+    output.push_back(' ');
+    output.append(std::to_string(ship_type.size));
+    output.append(game->placed_ships[index] ? " placed " : " unplaced ");
+    AppendLine(output, ship_type.name);
+  }
+
+  AppendLine(output, "OK");
+}
+
+void GameSession::PlaceShip(const std::string_view text, std::string& output) {
+  if (state != SessionState::Placing) {
+    AppendError(output, "ships can only be placed before the game starts");
+    return;
+  }
+
+  std::string_view arguments = text;
+  const std::string_view number_text = TakeWord(arguments);
+  const std::string_view orientation_text = TakeWord(arguments);
+  const std::string_view location_text = TakeWord(arguments);
+
+  const int ship = ParseShipNumber(number_text, game->placed_ships.size());
+
+  if (ship == 0) {
+    AppendError(output, "unknown ship");
+    return;
+  }
+
+  if (game->placed_ships[ship - 1]) {
+    AppendError(output, "ship already placed");
+    return;
+  }
+
+  Orientation orientation;
+
+  if (IsWord(orientation_text, "h")) {
+    orientation = Orientation::Horizontal;
+  } else if (IsWord(orientation_text, "v")) {
+    orientation = Orientation::Vertical;
+  } else {
+    AppendError(output, "orientation must be h or v");
+    return;
+  }
+
+  Coordinate coordinate;
+
+  if (ParseCoordinate(location_text, coordinate) != CoordinateError::None) {
+    AppendError(output, "invalid location");
+    return;
+  }
+
+  if (!game->player_board.AddBoat(configuration.ship_types[ship - 1],
+                                  Location(coordinate.column, coordinate.row),
+                                  orientation)) {
+    AppendError(output, "ship does not fit there");
+    return;
+  }
+
+  game->placed_ships[ship - 1] = true;
+  AppendLine(output, "OK");
+}
+
+void GameSession::AutoPlaceShips(std::string& output) {
+  if (state != SessionState::Placing) {
+    AppendError(output, "ships can only be placed before the game starts");
+    return;
+  }
+
+  std::vector<ShipType> remaining_ships;
+
+  for (int index = 0; index < static_cast<int>(game->placed_ships.size()); ++index) {
+    if (!game->placed_ships[index]) {
+      remaining_ships.emplace_back(configuration.ship_types[index]);
+    }
+  }
+
+  AutoPlacer auto_placer(game->player_board, placement_generator);
+
+  if (!auto_placer.AutoPlace(remaining_ships)) {
+    AppendError(output, "the remaining ships do not fit");
+    return;
+  }
+
+  std::fill(game->placed_ships.begin(), game->placed_ships.end(), true);
+  AppendLine(output, "OK");
+}
+
+void GameSession::ResetShips(std::string& output) {
+  if (state != SessionState::Placing) {
+    AppendError(output, "ships can only be placed before the game starts");
+    return;
+  }
+
+  game->player_board.Reset();
+  std::fill(game->placed_ships.begin(), game->placed_ships.end(), false);
+  AppendLine(output, "OK");
+}
+
+void GameSession::StartGame(std::string& output) {
+  if (state != SessionState::Placing) {
+    AppendError(output, "the game has already started");
+    return;
+  }
+
+  for (const bool is_placed : game->placed_ships) {
+    if (!is_placed) {
+      AppendError(output, "not every ship is placed");
+      return;
+    }
+  }
+
+  AutoPlacer computer_auto_placer(game->computer_board, placement_generator);
+
+  if (!computer_auto_placer.AutoPlace(configuration.ship_types)) {
+    AppendError(output, "the computer's fleet does not fit");
+    return;
+  }
+
+  if (fire_mode == HIDDEN_MINES) {
+    game->computer_board.AddRandomMines(placement_generator);
+  }
+
+  state = SessionState::Playing;
+  shots_left = ShotsPerTurn(game->player_board);
+  AppendLine(output, "OK");
+}
+
+void GameSession::Fire(const std::string_view text, std::string& output) {
+  if (state != SessionState::Playing) {
+    AppendError(output, "the game is not in progress");
+    return;
+  }
+
+  std::string_view arguments = text;
+  Coordinate coordinate;
+
+  if (ParseCoordinate(TakeWord(arguments), coordinate) != CoordinateError::None) {
+    AppendError(output, "invalid location");
+    return;
+  }
+
+  const Location location(coordinate.column, coordinate.row);
+
+  if (!game->computer_board.Shoot(location)) {
+    AppendError(output, "invalid shot");
+    return;
+  }
+
+  output.append("SHOT ");
+  output.append(location.ToString());
+  output.push_back(' ');
+  AppendLine(output, ShotResultName(game->computer_board, location));
+
+  if (game->computer_board.AreAllShipsSunk()) {
+    state = SessionState::Finished;
+    AppendLine(output, "WIN");
+  } else if (--shots_left == 0) {
+    ComputerTurn(output);
+  }
+
+  AppendLine(output, "OK");
+}
+
+void GameSession::ComputerTurn(std::string& output) {
+  const std::vector<Location> volley =
+      game->computer_ai.ChooseVolley(ShotsPerTurn(game->computer_board));
+  const std::vector<ShotOutcome> outcomes = game->player_board.ShootMany(volley);
+
+  for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+    if (outcomes[shot] != ShotOutcome::Rejected) {
+      output.append("INCOMING ");
+      output.append(volley[shot].ToString());
+      output.push_back(' ');
+      AppendLine(output, ShotResultName(game->player_board, volley[shot]));
+    }
+  }
+
+  if (game->player_board.AreAllShipsSunk()) {
+    state = SessionState::Finished;
+    AppendLine(output, "LOSE");
+    return;
+  }
+
+  shots_left = ShotsPerTurn(game->player_board);
+}
+
+void GameSession::RenderBoards(std::string& output) const {
+  output.append(game->player_board_renderer.Render());
+  output.append(game->computer_board_renderer.Render());
+  AppendLine(output, "OK");
+}
+
+// Salvo turns fire one shot per ship the shooter still has afloat.
+int GameSession::ShotsPerTurn(const Board& board) const {
+  if (fire_mode == SALVO) {
+    return board.RemainingShipsCount();
+  }
+
+  return 1;
+}
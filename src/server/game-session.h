@@ -0,0 +1,105 @@
+#ifndef SRC_SERVER_GAME_SESSION_H
+#define SRC_SERVER_GAME_SESSION_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board/random-placement-generator.h"
+#include "board-renderer/board-renderer.h"
+#include "computer-ai.h"
+#include "configuration/configuration.h"
+#include "fire-mode.h"
+
+enum class SessionState {
+  // The player is placing their fleet.
+  Placing,
+  Playing,
+  Finished
+};
+
+// One client's game against the computer, driven a line at a time instead of through stdin so
+// that many of them can share a process. Every command is answered by zero or more data lines and
+// then a single "OK" or "ERR <reason>" line:
+//
+//   NEW [normal|salvo|mines] [random|density|montecarlo|parity]
+//                              starts over, in normal mode against a computer targeting at random
+//                              unless told otherwise
+//   SHIPS                      lists "<number> <size> placed|unplaced <name>" for every ship
+//   PLACE <number> <h|v> <xy>  places a ship, e.g. "PLACE 1 h A1"
+//   AUTO                       places the remaining ships randomly
+//   RESET                      takes every placed ship off the board
+//   START                      starts firing once the whole fleet is placed
+//   FIRE <xy>                  fires one shot, answered by "SHOT <xy> HIT|MISS|MINE" and, once the
+//                              turn is over, the computer's "INCOMING <xy> HIT|MISS|MINE" shots,
+//                              with "WIN" or "LOSE" when the game ends
+//   BOARD                      renders the player's board and then the opponent's
+//   QUIT                       ends the session
+class GameSession {
+public:
+  explicit GameSession(const Configuration& configuration);
+  explicit GameSession(const Configuration& configuration,
+                       const std::uint64_t seed,
+                       const RandomEngine random_engine = RandomEngine::MersenneTwister);
+
+  GameSession(const GameSession&) = delete;
+  GameSession& operator=(const GameSession&) = delete;
+
+  std::string HandleLine(const std::string_view line);
+
+  SessionState GetState() const;
+  bool IsClosed() const;
+
+private:
+  // Everything one game needs. The renderers and the computer keep references to the boards, so a
+  // game is only ever constructed in place.
+  struct Game {
+    explicit Game(const Configuration& configuration,
+                  const FleetRegistry& fleet_registry,
+                  PlacementGenerator& placement_generator)
+      : player_board(configuration.board_width, configuration.board_height, fleet_registry),
+        computer_board(configuration.board_width, configuration.board_height, fleet_registry),
+        player_board_renderer(player_board),
+        computer_board_renderer(computer_board),
+        computer_ai(player_board, placement_generator),
+        placed_ships(configuration.ship_types.size(), false) {
+      computer_board_renderer.SetMode(TARGET);
+      // Counted rather than timed, so that a session's seed deals the same game every time.
+      computer_ai.SetMoveAttemptBudget(FleetSampler::max_samples);
+    }
+
+    Board player_board;
+    Board computer_board;
+    BoardRenderer player_board_renderer;
+    BoardRenderer computer_board_renderer;
+    ComputerAi computer_ai;
+    std::vector<bool> placed_ships;
+  };
+
+  void NewGame(const std::string_view arguments, std::string& output);
+  void ListShips(std::string& output) const;
+  void PlaceShip(const std::string_view arguments, std::string& output);
+  void AutoPlaceShips(std::string& output);
+  void ResetShips(std::string& output);
+  void StartGame(std::string& output);
+  void Fire(const std::string_view arguments, std::string& output);
+  void ComputerTurn(std::string& output);
+  void RenderBoards(std::string& output) const;
+
+  int ShotsPerTurn(const Board& board) const;
+
+  const Configuration& configuration;
+  FleetRegistry fleet_registry;
+  RandomPlacementGenerator placement_generator;
+  FireMode fire_mode = NORMAL;
+  TargetingMode targeting_mode = TargetingMode::Random;
+  SessionState state = SessionState::Placing;
+  std::optional<Game> game;
+  // Shots the player may still fire before the computer's turn.
+  int shots_left = 0;
+  bool is_closed = false;
+};
+
+#endif // SRC_SERVER_GAME_SESSION_H
@@ -0,0 +1,446 @@
+#include "session-server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "game-session.h"
+
+// Event loop ids for the two descriptors that aren't connections. Connections count up from
+// first_connection_id, so an id is never reused even when its descriptor number is.
+constexpr std::uint64_t listen_id = 0;
+constexpr std::uint64_t wake_id = 1;
+constexpr std::uint64_t first_connection_id = 2;
+
+constexpr int max_events = 256;
+constexpr int read_size = 4096;
+
+bool AddEvents(const int epoll_descriptor, const int descriptor, const std::uint64_t id,
+               const std::uint32_t events) {
+  epoll_event event{};
+  event.events = events;
+  event.data.u64 = id;
+
+  return epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, descriptor, &event) == 0;
+}
+
+void ClearWakeCount(const int wake_descriptor) {
+  std::uint64_t count;
+
+  while (read(wake_descriptor, &count, sizeof(count)) == sizeof(count)) {
+  }
+}
+
+SessionServer::SessionServer(const Configuration& configuration,
+                             std::string socket_path,
+                             const int worker_count,
+                             const std::uint64_t seed,
+                             const RandomEngine random_engine)
+  : configuration(configuration),
+    socket_path(std::move(socket_path)),
+    worker_count(worker_count),
+    seed(seed),
+    random_engine(random_engine),
+    next_connection_id(first_connection_id) {
+  if (this->worker_count <= 0) {
+    this->worker_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+}
+
+SessionServer::~SessionServer() {
+  for (const auto& [connection_id, connection] : connections) {
+    close(connection.socket);
+  }
+
+  for (const int descriptor : { listen_socket, epoll_descriptor, wake_descriptor }) {
+    if (descriptor >= 0) {
+      close(descriptor);
+    }
+  }
+
+  if (listen_socket >= 0) {
+    unlink(socket_path.c_str());
+  }
+}
+
+int SessionServer::GetWorkerCount() const {
+  return worker_count;
+}
+
+int SessionServer::GetConnectionCount() const {
+  return connection_count.load();
+}
+
+bool SessionServer::Listen() {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+
+  if (socket_path.empty() || (socket_path.size() >= sizeof(address.sun_path))) {
+    return false;
+  }
+
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+  listen_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+  wake_descriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  if ((listen_socket < 0) || (epoll_descriptor < 0) || (wake_descriptor < 0)) {
+    return false;
+  }
+
+  unlink(socket_path.c_str());
+
+  return (bind(listen_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) &&
+         (listen(listen_socket, SOMAXCONN) == 0) &&
+         AddEvents(epoll_descriptor, listen_socket, listen_id, EPOLLIN) &&
+         AddEvents(epoll_descriptor, wake_descriptor, wake_id, EPOLLIN);
+}
+
+void SessionServer::Stop() {
+  is_stopping.store(true);
+
+  const std::uint64_t count = 1;
+  [[maybe_unused]] const ssize_t written = write(wake_descriptor, &count, sizeof(count));
+}
+
+void SessionServer::Run() {
+  workers.clear();
+
+  for (int index = 0; index < worker_count; ++index) {
+    workers.emplace_back(std::make_unique<Worker>());
+  }
+
+  for (const std::unique_ptr<Worker>& worker : workers) {
+    worker->thread = std::thread(&SessionServer::RunWorker, this, std::ref(*worker));
+  }
+
+  epoll_event events[max_events];
+
+  while (!is_stopping.load()) {
+    const int event_count = epoll_wait(epoll_descriptor, events, max_events, -1);
+
+    for (int index = 0; index < event_count; ++index) {
+      const std::uint64_t id = events[index].data.u64;
+      const std::uint32_t flags = events[index].events;
+
+      if (id == listen_id) {
+        AcceptConnections();
+      } else if (id == wake_id) {
+        ClearWakeCount(wake_descriptor);
+        DeliverReplies();
+      } else if (flags & EPOLLERR) {
+        CloseConnection(id);
+      } else if (flags & EPOLLHUP) {
+        // The lines the client sent before hanging up are still handed to its session.
+        ReadConnection(id);
+        CloseConnection(id);
+      } else {
+        if (flags & EPOLLIN) {
+          ReadConnection(id);
+        }
+
+        if (flags & EPOLLOUT) {
+          WriteConnection(id);
+        }
+      }
+    }
+  }
+
+  for (const std::unique_ptr<Worker>& worker : workers) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->is_stopping = true;
+    }
+
+    worker->condition.notify_one();
+    worker->thread.join();
+  }
+
+  workers.clear();
+}
+
+// Owns the sessions of every connection pinned to the worker, handling their lines in batches and
+// handing the replies back to the event loop in one go.
+void SessionServer::RunWorker(Worker& worker) {
+  std::unordered_map<std::uint64_t, std::unique_ptr<GameSession>> sessions;
+  std::deque<Job> jobs;
+  std::vector<Reply> worker_replies;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.condition.wait(lock, [&worker]() {
+        return worker.is_stopping || !worker.jobs.empty();
+      });
+
+      if (worker.is_stopping) {
+        return;
+      }
+
+      jobs.swap(worker.jobs);
+    }
+
+    for (Job& job : jobs) {
+      if (job.is_close) {
+        sessions.erase(job.connection_id);
+        continue;
+      }
+
+      std::unique_ptr<GameSession>& session = sessions[job.connection_id];
+
+      if (!session) {
+        session = std::make_unique<GameSession>(configuration,
+                                                MixSeed(seed, job.connection_id),
+                                                random_engine);
+      }
+
+      // A closed session is kept until its connection goes, answering any lines the client sent
+      // after quitting with an error instead of starting a new game.
+      worker_replies.push_back(Reply{ job.connection_id, session->HandleLine(job.line),
+                                      session->IsClosed() });
+    }
+
+    jobs.clear();
+
+    if (!worker_replies.empty()) {
+      {
+        std::lock_guard<std::mutex> lock(replies_mutex);
+        std::move(worker_replies.begin(), worker_replies.end(), std::back_inserter(replies));
+      }
+
+      worker_replies.clear();
+
+      const std::uint64_t count = 1;
+      [[maybe_unused]] const ssize_t written = write(wake_descriptor, &count, sizeof(count));
+    }
+  }
+}
+
+void SessionServer::PostJob(const std::uint64_t connection_id, std::string line,
+                            const bool is_close) {
+  Worker& worker = *workers[connection_id % workers.size()];
+
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.jobs.push_back(Job{ connection_id, std::move(line), is_close });
+  }
+
+  worker.condition.notify_one();
+}
+
+void SessionServer::AcceptConnections() {
+  while (true) {
+    const int socket = accept4(listen_socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (socket < 0) {
+      // Either nothing is left to accept or the process is out of descriptors, in which case the
+      // client stays queued until a connection closes.
+      return;
+    }
+
+    const std::uint64_t connection_id = next_connection_id++;
+
+    if (!AddEvents(epoll_descriptor, socket, connection_id, EPOLLIN)) {
+      close(socket);
+      continue;
+    }
+
+    Connection connection;
+    connection.socket = socket;
+    connection.events = EPOLLIN;
+    connections.emplace(connection_id, std::move(connection));
+    connection_count.fetch_add(1);
+  }
+}
+
+void SessionServer::ReadConnection(const std::uint64_t connection_id) {
+  const auto found = connections.find(connection_id);
+
+  if (found == connections.end()) {
+    return;
+  }
+
+  Connection& connection = found->second;
+  char buffer[read_size];
+
+  while (connection.is_reading) {
+    const ssize_t size = read(connection.socket, buffer, sizeof(buffer));
+
+    if (size > 0) {
+      connection.input.append(buffer, size);
+      DispatchLines(connection_id, connection);
+
+      if (connection.is_closing) {
+        break;
+      }
+    } else if ((size < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+      break;
+    } else if ((size < 0) && (errno == EINTR)) {
+      continue;
+    } else if (size == 0) {
+      // The client is done sending but still gets the replies to the lines it sent.
+      connection.is_reading = false;
+      connection.is_closing = true;
+    } else {
+      CloseConnection(connection_id);
+      return;
+    }
+  }
+
+  WriteConnection(connection_id);
+}
+
+// Hands complete lines to the connection's worker until it has max_pending_lines of them, leaving
+// the rest in the input buffer until replies come back.
+void SessionServer::DispatchLines(const std::uint64_t connection_id, Connection& connection) {
+  std::size_t start = 0;
+
+  while (connection.pending_lines < max_pending_lines) {
+    const std::size_t end = connection.input.find('\n', start);
+
+    if (end == std::string::npos) {
+      break;
+    }
+
+    if (end - start > static_cast<std::size_t>(max_line_length)) {
+      RejectLongLine(connection);
+      return;
+    }
+
+    PostJob(connection_id, connection.input.substr(start, end - start), false);
+    ++connection.pending_lines;
+    start = end + 1;
+  }
+
+  connection.input.erase(0, start);
+  connection.is_reading = connection.pending_lines < max_pending_lines;
+
+  // A line that can't be complete within the limit is never going to be answered.
+  if (connection.is_reading &&
+      (connection.input.size() > static_cast<std::size_t>(max_line_length))) {
+    RejectLongLine(connection);
+  }
+}
+
+// Stops reading from a connection that sent a line over max_line_length and closes it once the
+// error has followed the replies to the lines before it.
+void SessionServer::RejectLongLine(Connection& connection) {
+  connection.input.clear();
+  connection.is_reading = false;
+  connection.is_closing = true;
+
+  if (connection.pending_lines == 0) {
+    connection.output.append("ERR line too long\n");
+  } else {
+    connection.is_line_too_long = true;
+  }
+}
+
+void SessionServer::WriteConnection(const std::uint64_t connection_id) {
+  const auto found = connections.find(connection_id);
+
+  if (found == connections.end()) {
+    return;
+  }
+
+  Connection& connection = found->second;
+
+  while (!connection.output.empty()) {
+    const ssize_t size = send(connection.socket, connection.output.data(),
+                              connection.output.size(), MSG_NOSIGNAL);
+
+    if (size > 0) {
+      connection.output.erase(0, size);
+    } else if ((size < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+      break;
+    } else if ((size < 0) && (errno == EINTR)) {
+      continue;
+    } else {
+      CloseConnection(connection_id);
+      return;
+    }
+  }
+
+  if (connection.output.empty() && connection.is_closing && (connection.pending_lines == 0)) {
+    CloseConnection(connection_id);
+    return;
+  }
+
+  UpdateEvents(connection_id, connection);
+}
+
+void SessionServer::DeliverReplies() {
+  std::vector<Reply> ready_replies;
+
+  {
+    std::lock_guard<std::mutex> lock(replies_mutex);
+    ready_replies.swap(replies);
+  }
+
+  for (Reply& reply : ready_replies) {
+    const auto found = connections.find(reply.connection_id);
+
+    // The client may have hung up while its line was being handled.
+    if (found == connections.end()) {
+      continue;
+    }
+
+    Connection& connection = found->second;
+    connection.output.append(reply.text);
+    --connection.pending_lines;
+
+    if (connection.is_line_too_long && (connection.pending_lines == 0)) {
+      connection.output.append("ERR line too long\n");
+      connection.is_line_too_long = false;
+    }
+
+    if (reply.is_closing) {
+      connection.is_closing = true;
+      connection.is_reading = false;
+      connection.input.clear();
+    } else if (!connection.is_closing && !connection.is_reading) {
+      DispatchLines(reply.connection_id, connection);
+    }
+
+    WriteConnection(reply.connection_id);
+  }
+}
+
+void SessionServer::UpdateEvents(const std::uint64_t connection_id, Connection& connection) {
+  const std::uint32_t events =
+      (connection.is_reading ? static_cast<std::uint32_t>(EPOLLIN) : 0) |
+      (connection.output.empty() ? 0 : static_cast<std::uint32_t>(EPOLLOUT));
+
+  if (events == connection.events) {
+    return;
+  }
+
+  connection.events = events;
+
+  epoll_event event{};
+  event.events = events;
+  event.data.u64 = connection_id;
+  epoll_ctl(epoll_descriptor, EPOLL_CTL_MOD, connection.socket, &event);
+}
+
+void SessionServer::CloseConnection(const std::uint64_t connection_id) {
+  const auto found = connections.find(connection_id);
+
+  if (found == connections.end()) {
+    return;
+  }
+
+  epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, found->second.socket, nullptr);
+  close(found->second.socket);
+  connections.erase(found);
+  connection_count.fetch_sub(1);
+
+  PostJob(connection_id, std::string(), true);
+}
@@ -0,0 +1,124 @@
+#ifndef SRC_SERVER_SESSION_SERVER_H
+#define SRC_SERVER_SESSION_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "board/random-placement-generator.h"
+#include "configuration/configuration.h"
+
+// Hosts one GameSession per client connected to a Unix domain socket. A single thread runs a
+// non-blocking epoll loop that accepts connections, splits their input into lines and writes back
+// the replies, while the sessions themselves live on a small pool of worker threads. Every
+// connection is pinned to one worker, so its lines are handled in order and its session is only
+// ever touched by that worker's thread, and a connection with max_pending_lines unanswered lines
+// isn't read from again until it has caught up.
+class SessionServer {
+public:
+  static constexpr int max_line_length = 1024;
+  static constexpr int max_pending_lines = 64;
+
+  // A worker count of 0 uses one worker per hardware thread. Each connection's game is seeded with
+  // seed mixed with the connection's number, so a run with the same seed and the same order of
+  // connections deals the same games.
+  explicit SessionServer(const Configuration& configuration,
+                         std::string socket_path,
+                         const int worker_count = 0,
+                         const std::uint64_t seed = 0,
+                         const RandomEngine random_engine = RandomEngine::MersenneTwister);
+  ~SessionServer();
+
+  SessionServer(const SessionServer&) = delete;
+  SessionServer& operator=(const SessionServer&) = delete;
+
+  // Creates the socket, replacing any stale one at the path, and starts listening. Clients can
+  // connect as soon as this returns true, even before Run.
+  bool Listen();
+  // Serves clients until Stop is called.
+  void Run();
+  // Makes Run return. Only writes to an eventfd, so it is safe to call from another thread or from
+  // a signal handler.
+  void Stop();
+
+  int GetWorkerCount() const;
+  int GetConnectionCount() const;
+
+private:
+  struct Job {
+    std::uint64_t connection_id;
+    std::string line;
+    // Set when the connection has gone and its session should be dropped.
+    bool is_close;
+  };
+
+  struct Reply {
+    std::uint64_t connection_id;
+    std::string text;
+    bool is_closing;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Job> jobs;
+    bool is_stopping = false;
+    std::thread thread;
+  };
+
+  struct Connection {
+    int socket;
+    std::string input;
+    std::string output;
+    int pending_lines = 0;
+    bool is_reading = true;
+    // The events the connection is registered for in the event loop.
+    std::uint32_t events = 0;
+    // Set once the session has ended, so the connection closes when its output is written.
+    bool is_closing = false;
+    // Set when a line was too long while earlier lines were still unanswered.
+    bool is_line_too_long = false;
+  };
+
+  void RunWorker(Worker& worker);
+  void PostJob(const std::uint64_t connection_id, std::string line, const bool is_close);
+
+  void AcceptConnections();
+  void ReadConnection(const std::uint64_t connection_id);
+  void DispatchLines(const std::uint64_t connection_id, Connection& connection);
+  void RejectLongLine(Connection& connection);
+  void WriteConnection(const std::uint64_t connection_id);
+  void DeliverReplies();
+  void UpdateEvents(const std::uint64_t connection_id, Connection& connection);
+  void CloseConnection(const std::uint64_t connection_id);
+
+  const Configuration& configuration;
+  std::string socket_path;
+  int worker_count;
+  std::uint64_t seed;
+  RandomEngine random_engine;
+  int listen_socket = -1;
+  int epoll_descriptor = -1;
+  // Wakes the event loop when replies are ready or Stop is called.
+  int wake_descriptor = -1;
+  std::atomic<bool> is_stopping{ false };
+  std::atomic<int> connection_count{ 0 };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  std::mutex replies_mutex;
+  std::vector<Reply> replies;
+
+  // Event loop state, only touched by the thread in Run.
+  std::unordered_map<std::uint64_t, Connection> connections;
+  std::uint64_t next_connection_id;
+};
+
+#endif // SRC_SERVER_SESSION_SERVER_H
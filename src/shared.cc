@@ -1,5 +1,7 @@
 #include "shared.h"
 
+#include <array>
+
 char IntToChar(const int value) {
   char letter = 'A';
   letter += static_cast<char>(value); // {value} letters further down the alphabet from A
@@ -17,6 +19,131 @@ std::string CoordinateIndexToLetter(const int index) {
   return std::string() + IntToChar(index);
 }
 
+struct CoordinateTables {
+  // Column letters for each coordinate, null terminated, with their length.
+  std::array<std::array<char, 3>, max_coordinate + 1> letters{};
+  std::array<int, max_coordinate + 1> letter_counts{};
+  // 1 to 26 for letters of either case, 0 for anything else.
+  std::array<int, 256> letter_values{};
+};
+
+CoordinateTables BuildCoordinateTables() {
+  CoordinateTables tables;
+
+  for (int coordinate = 1; coordinate <= max_coordinate; ++coordinate) {
+    const std::string letters = CoordinateIndexToLetter(coordinate - 1);
+
+    for (int index = 0; index < static_cast<int>(letters.size()); ++index) {
+      tables.letters[coordinate][index] = letters[index];
+    }
+
+    tables.letter_counts[coordinate] = letters.size();
+  }
+
+  for (int value = 1; value <= 26; ++value) {
+    tables.letter_values['A' + value - 1] = value;
+    tables.letter_values['a' + value - 1] = value;
+  }
+
+  return tables;
+}
+
+const CoordinateTables coordinate_tables = BuildCoordinateTables();
+
+bool IsCoordinateDigit(const char character) {
+  return (character >= '0') && (character <= '9');
+}
+
+int CoordinateLetterValue(const char character) {
+  return coordinate_tables.letter_values[static_cast<unsigned char>(character)];
+}
+
 std::string CoordinateToLetter(const int coordinate) {
+  const std::string_view letters = CoordinateLetters(coordinate);
+
+  if (!letters.empty()) {
+    return std::string(letters);
+  }
+
   return CoordinateIndexToLetter(coordinate - 1);
 }
+
+std::string_view CoordinateLetters(const int coordinate) {
+  if ((coordinate < 1) || (coordinate > max_coordinate)) {
+    return {};
+  }
+
+  return std::string_view(coordinate_tables.letters[coordinate].data(),
+                          coordinate_tables.letter_counts[coordinate]);
+}
+
+CoordinateError ParseCoordinateLetters(const std::string_view letters, int& column) {
+  if (letters.empty() || (letters.size() > 2)) {
+    return CoordinateError::InvalidFormat;
+  }
+
+  int value = 0;
+
+  for (const char character : letters) {
+    const int letter_value = CoordinateLetterValue(character);
+
+    if (letter_value == 0) {
+      return CoordinateError::InvalidFormat;
+    }
+
+    value = (26 * value) + letter_value;
+  }
+
+  if (value > max_coordinate) {
+    return CoordinateError::ColumnOutOfRange;
+  }
+
+  column = value;
+  return CoordinateError::None;
+}
+
+CoordinateError ParseCoordinate(const std::string_view text, Coordinate& coordinate) {
+  // Both halves are at most two characters long.
+  if ((text.size() < 2) || (text.size() > 4)) {
+    return CoordinateError::InvalidFormat;
+  }
+
+  const bool is_letters_first = !IsCoordinateDigit(text.front());
+  std::size_t split = 0;
+
+  while ((split < text.size()) && (IsCoordinateDigit(text[split]) != is_letters_first)) {
+    ++split;
+  }
+
+  const std::string_view letters = is_letters_first ? text.substr(0, split) : text.substr(split);
+  const std::string_view digits = is_letters_first ? text.substr(split) : text.substr(0, split);
+
+  if (digits.empty() || (digits.size() > 2)) {
+    return CoordinateError::InvalidFormat;
+  }
+
+  int row = 0;
+
+  for (const char character : digits) {
+    if (!IsCoordinateDigit(character)) {
+      return CoordinateError::InvalidFormat;
+    }
+
+    row = (10 * row) + (character - '0');
+  }
+
+  int column = 0;
+  const CoordinateError column_error = ParseCoordinateLetters(letters, column);
+
+  if (column_error != CoordinateError::None) {
+    return column_error;
+  }
+
+  if ((row < 1) || (row > max_coordinate)) {
+    return CoordinateError::RowOutOfRange;
+  }
+
+  coordinate.column = column;
+  coordinate.row = row;
+  return CoordinateError::None;
+}
@@ -2,7 +2,32 @@
 #define SHARED_H
 
 #include <string>
+#include <string_view>
+
+// Largest column or row a coordinate can name, matching the largest supported board.
+constexpr int max_coordinate = 80;
+
+enum class CoordinateError {
+  None,
+  InvalidFormat,
+  ColumnOutOfRange,
+  RowOutOfRange
+};
+
+struct Coordinate {
+  int column = 0;
+  int row = 0;
+};
 
 std::string CoordinateToLetter(const int coordinate);
+// Same as CoordinateToLetter without allocating, for coordinates 1 to max_coordinate. Anything
+// else gives an empty view.
+std::string_view CoordinateLetters(const int coordinate);
+
+// Parses one or two column letters in either case, e.g. "b" or "AB", into a 1-based column.
+CoordinateError ParseCoordinateLetters(const std::string_view letters, int& column);
+// Parses a column-row index written either way round, e.g. "A2", "2a" or "AB12". Leaves coordinate
+// untouched unless the result is CoordinateError::None.
+CoordinateError ParseCoordinate(const std::string_view text, Coordinate& coordinate);
 
-#endif // SHARED_H
\ No newline at end of file
+#endif // SHARED_H
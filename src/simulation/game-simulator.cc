@@ -0,0 +1,292 @@
+#include "game-simulator.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "board/auto-placer.h"
+#include "board/fixed-board.h"
+
+bool SetUpBoard(const Configuration& configuration,
+                const FireMode fire_mode,
+                Board& board,
+                PlacementGenerator& placement_generator) {
+  AutoPlacer auto_placer(board, placement_generator);
+
+  if (!auto_placer.AutoPlace(configuration.ship_types)) {
+    return false;
+  }
+
+  if (fire_mode == HIDDEN_MINES) {
+    board.AddRandomMines(placement_generator);
+  }
+
+  return true;
+}
+
+// Returns true once the opponent's fleet has been sunk.
+bool SimulateTurn(const FireMode fire_mode,
+                  ComputerAi& computer_ai,
+                  const Board& computer_board,
+                  Board& opponent_board,
+                  PlayerStatistics& statistics) {
+  int shots = 1;
+
+  if (fire_mode == SALVO) {
+    shots = computer_board.RemainingShipsCount();
+  }
+
+  const std::vector<Location> volley = computer_ai.ChooseVolley(shots);
+  const std::vector<ShotOutcome> outcomes = opponent_board.ShootMany(volley);
+
+  for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+    if (outcomes[shot] == ShotOutcome::Rejected) {
+      continue;
+    }
+
+    ++statistics.shots;
+
+    if (opponent_board.IsMine(volley[shot])) {
+      ++statistics.mine_triggers;
+    }
+
+    if (opponent_board.IsHit(volley[shot])) {
+      ++statistics.hits;
+    }
+  }
+
+  return opponent_board.AreAllShipsSunk();
+}
+
+// ComputerAi's Random targeting on a FixedBoard, making the same choices from the same draws:
+// the four cells around every hit the last shot reached are stacked as targets, and with none left
+// a random not-fired cell is drawn. Targets are cell numbers, with -1 for no shot yet.
+// Volleys are planned as ComputerAi::ChooseVolley plans them.
+template<int Width, int Height>
+class FixedBoardRandomAi {
+public:
+  explicit FixedBoardRandomAi(const FixedBoard<Width, Height>& board,
+                              RandomPlacementGenerator& placement_generator)
+    : board(board), placement_generator(placement_generator) {}
+
+  int ChooseNextShot() {
+    const bool is_last_shot_on_board = (board.LastShotCount() > 0) &&
+                                       (board.LastShotCell(0) == last_shot);
+
+    if (is_last_shot_on_board) {
+      for (int index = 0; index < board.LastShotCount(); ++index) {
+        TargetCellsAroundHit(board.LastShotCell(index));
+      }
+    } else if ((last_shot >= 0) && board.IsCellShot(last_shot)) {
+      TargetCellsAroundHit(last_shot);
+    }
+
+    last_shot = ChooseFreeTarget();
+
+    return last_shot;
+  }
+
+  // Writes the volley's cells to volley and returns how many there are.
+  int ChooseVolley(const int count, std::array<int, Width * Height>& volley) {
+    const int volley_size = std::min(count, board.NotFiredCount());
+
+    if (volley_size <= 0) {
+      return 0;
+    }
+
+    volley[0] = ChooseNextShot();
+    planned_shots.set(volley[0]);
+
+    for (int shot = 1; shot < volley_size; ++shot) {
+      volley[shot] = ChooseFreeTarget();
+      planned_shots.set(volley[shot]);
+    }
+
+    for (int shot = 0; shot < volley_size; ++shot) {
+      planned_shots.reset(volley[shot]);
+    }
+
+    return volley_size;
+  }
+
+private:
+  static constexpr int stride = FixedBoard<Width, Height>::stride;
+  // Above, below, left and right, in ComputerAi's order.
+  static constexpr std::array<int, 4> around_offsets = { -stride, stride, -1, 1 };
+
+  int ChooseFreeTarget() {
+    int target;
+
+    do {
+      if (next_targets_count == 0) {
+        target = board.NotFiredCell(placement_generator.ChooseIndex(board.NotFiredCount()));
+      } else {
+        target = next_targets[--next_targets_count];
+      }
+    } while (board.IsCellShot(target) || planned_shots.test(target));
+
+    return target;
+  }
+
+  void TargetCellsAroundHit(const int cell) {
+    if (board.IsCellMine(cell) || !board.IsCellHit(cell)) {
+      return;
+    }
+
+    for (const int offset : around_offsets) {
+      if (!board.IsCellShot(cell + offset)) {
+        next_targets[next_targets_count++] = cell + offset;
+      }
+    }
+  }
+
+  const FixedBoard<Width, Height>& board;
+  RandomPlacementGenerator& placement_generator;
+  int last_shot = -1;
+  // Only unshot cells around a hit are stacked and a cell is hit once, so four per cell at most.
+  std::array<std::uint16_t, 4 * Width * Height> next_targets{};
+  int next_targets_count = 0;
+  std::bitset<FixedBoard<Width, Height>::cell_count> planned_shots;
+};
+
+template<int Width, int Height>
+bool SimulateFixedBoardTurn(const FireMode fire_mode,
+                            FixedBoardRandomAi<Width, Height>& computer_ai,
+                            const FixedBoard<Width, Height>& computer_board,
+                            FixedBoard<Width, Height>& opponent_board,
+                            PlayerStatistics& statistics) {
+  const int shots = (fire_mode == SALVO) ? computer_board.RemainingShipsCount() : 1;
+  std::array<int, Width * Height> volley;
+  std::array<ShotOutcome, Width * Height> outcomes;
+  const int volley_size = computer_ai.ChooseVolley(shots, volley);
+
+  opponent_board.ShootMany(volley.data(), volley_size, outcomes.data());
+
+  for (int shot = 0; shot < volley_size; ++shot) {
+    if (outcomes[shot] != ShotOutcome::Rejected) {
+      ++statistics.shots;
+      statistics.mine_triggers += opponent_board.IsCellMine(volley[shot]);
+      statistics.hits += opponent_board.IsCellHit(volley[shot]);
+    }
+  }
+
+  return opponent_board.AreAllShipsSunk();
+}
+
+// The turns of PlayGame, played on fixed size copies of the two boards.
+template<int Width, int Height>
+void PlayFixedBoardGame(const FireMode fire_mode,
+                        const Board& board_1,
+                        const Board& board_2,
+                        RandomPlacementGenerator& placement_generator,
+                        GameStatistics& game_statistics) {
+  FixedBoard<Width, Height> computer_1_board(board_1);
+  FixedBoard<Width, Height> computer_2_board(board_2);
+  FixedBoardRandomAi<Width, Height> computer_1_ai(computer_2_board, placement_generator);
+  FixedBoardRandomAi<Width, Height> computer_2_ai(computer_1_board, placement_generator);
+
+  while (game_statistics.turns < Width * Height) {
+    ++game_statistics.turns;
+
+    if (SimulateFixedBoardTurn(fire_mode, computer_1_ai, computer_1_board, computer_2_board,
+                               game_statistics.players[0])) {
+      game_statistics.winner = 1;
+      break;
+    }
+
+    if (SimulateFixedBoardTurn(fire_mode, computer_2_ai, computer_2_board, computer_1_board,
+                               game_statistics.players[1])) {
+      game_statistics.winner = 2;
+      break;
+    }
+  }
+}
+
+// Plays on the FixedBoard matching the boards' size, returning false if there is none.
+template<int... Sizes>
+bool DispatchFixedBoardGame(std::integer_sequence<int, Sizes...>,
+                            const FireMode fire_mode,
+                            const Board& board_1,
+                            const Board& board_2,
+                            RandomPlacementGenerator& placement_generator,
+                            GameStatistics& game_statistics) {
+  const int width = board_1.GetWidth();
+  const int height = board_1.GetHeight();
+
+  return (((width == Sizes) && (height == Sizes) &&
+           (PlayFixedBoardGame<Sizes, Sizes>(fire_mode, board_1, board_2, placement_generator,
+                                             game_statistics), true)) || ...);
+}
+
+void GameSimulator::SetTargetingMode(const int player, const TargetingMode targeting_mode) {
+  targeting_modes.at(player - 1) = targeting_mode;
+}
+
+GameStatistics GameSimulator::PlayGame(const FireMode fire_mode) {
+  GameStatistics game_statistics;
+
+  Board computer_1_board(configuration.board_width, configuration.board_height, fleet_registry);
+  Board computer_2_board(configuration.board_width, configuration.board_height, fleet_registry);
+
+  if (!SetUpBoard(configuration, fire_mode, computer_1_board, placement_generator) ||
+      !SetUpBoard(configuration, fire_mode, computer_2_board, placement_generator)) {
+    return game_statistics;
+  }
+
+  const bool can_play_fixed_board = (random_placement_generator != nullptr) &&
+                                    (targeting_modes[0] == TargetingMode::Random) &&
+                                    (targeting_modes[1] == TargetingMode::Random);
+
+  if (can_play_fixed_board &&
+      DispatchFixedBoardGame(FixedBoardSizes(), fire_mode, computer_1_board, computer_2_board,
+                             *random_placement_generator, game_statistics)) {
+    if (game_statistics.winner != 0) {
+      game_statistics.shots_to_win = game_statistics.players[game_statistics.winner - 1].shots;
+    }
+
+    return game_statistics;
+  }
+
+  ComputerAi computer_1_ai(computer_2_board, placement_generator);
+  ComputerAi computer_2_ai(computer_1_board, placement_generator);
+  computer_1_ai.SetTargetingMode(targeting_modes[0]);
+  computer_2_ai.SetTargetingMode(targeting_modes[1]);
+  computer_1_ai.SetMoveAttemptBudget(monte_carlo_move_attempts);
+  computer_2_ai.SetMoveAttemptBudget(monte_carlo_move_attempts);
+
+  // Every turn fires at least one new shot, so a game can never outlast both boards being
+  // completely fired upon.
+  const int max_turns = computer_1_board.GetWidth() * computer_1_board.GetHeight();
+
+  while (game_statistics.turns < max_turns) {
+    ++game_statistics.turns;
+
+    if (SimulateTurn(fire_mode, computer_1_ai, computer_1_board, computer_2_board,
+                     game_statistics.players[0])) {
+      game_statistics.winner = 1;
+      break;
+    }
+
+    if (SimulateTurn(fire_mode, computer_2_ai, computer_2_board, computer_1_board,
+                     game_statistics.players[1])) {
+      game_statistics.winner = 2;
+      break;
+    }
+  }
+
+  if (game_statistics.winner != 0) {
+    game_statistics.shots_to_win = game_statistics.players[game_statistics.winner - 1].shots;
+  }
+
+  return game_statistics;
+}
+
+std::vector<GameStatistics> GameSimulator::PlayGames(const int count, const FireMode fire_mode) {
+  std::vector<GameStatistics> games;
+  games.reserve(count);
+
+  for (int game = 0; game < count; ++game) {
+    games.emplace_back(PlayGame(fire_mode));
+  }
+
+  return games;
+}
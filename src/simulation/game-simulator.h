@@ -0,0 +1,70 @@
+#ifndef SRC_SIMULATION_GAME_SIMULATOR_H
+#define SRC_SIMULATION_GAME_SIMULATOR_H
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "board/placement-generator.h"
+#include "board/random-placement-generator.h"
+#include "computer-ai.h"
+#include "configuration/configuration.h"
+#include "fire-mode.h"
+
+struct PlayerStatistics {
+  int shots = 0;
+  int hits = 0;
+  int mine_triggers = 0;
+};
+
+struct GameStatistics {
+  // 1 or 2 for the winning computer, 0 if a fleet could not be placed and no game was played.
+  int winner = 0;
+  int turns = 0;
+  int shots_to_win = 0;
+  std::array<PlayerStatistics, 2> players;
+};
+
+// Plays complete computer vs computer games without rendering or reading input, following the
+// same turn rules as the interactive game modes. Games between two Random computers on one of the
+// board sizes in FixedBoardSizes are played on a FixedBoard of that size once the boards are set
+// up, which gives the same games from the same draws. That needs a RandomPlacementGenerator,
+// whose draws for a random not-fired location are known; any other generator plays on Board.
+class GameSimulator {
+public:
+  explicit GameSimulator(const Configuration& configuration,
+                         PlacementGenerator& placement_generator)
+    : configuration(configuration),
+      fleet_registry(configuration.ship_types),
+      placement_generator(placement_generator) {}
+
+  explicit GameSimulator(const Configuration& configuration,
+                         RandomPlacementGenerator& placement_generator)
+    : configuration(configuration),
+      fleet_registry(configuration.ship_types),
+      placement_generator(placement_generator),
+      random_placement_generator(&placement_generator) {}
+
+  // Layouts a MonteCarlo computer samples per move, counted rather than timed so that the same
+  // seed plays the same game.
+  static constexpr int monte_carlo_move_attempts = FleetSampler::max_samples;
+
+  // Square board sizes with a FixedBoard kernel.
+  using FixedBoardSizes = std::integer_sequence<int, 8, 10, 12, 15, 20>;
+
+  // player is 1 or 2, matching GameStatistics::winner.
+  void SetTargetingMode(const int player, const TargetingMode targeting_mode);
+
+  GameStatistics PlayGame(const FireMode fire_mode);
+  std::vector<GameStatistics> PlayGames(const int count, const FireMode fire_mode);
+
+private:
+  const Configuration& configuration;
+  FleetRegistry fleet_registry;
+  PlacementGenerator& placement_generator;
+  // Only set when the generator is known to be a RandomPlacementGenerator.
+  RandomPlacementGenerator* random_placement_generator = nullptr;
+  std::array<TargetingMode, 2> targeting_modes{ TargetingMode::Random, TargetingMode::Random };
+};
+
+#endif // SRC_SIMULATION_GAME_SIMULATOR_H
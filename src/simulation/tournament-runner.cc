@@ -0,0 +1,154 @@
+#include "tournament-runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "board/random-placement-generator.h"
+
+// The chunks a worker still has to play, packed as [front, back) into a single word so that the
+// owner taking from the front and thieves taking from the back never claim the same chunk.
+class ChunkRange {
+public:
+  void Assign(const int front, const int back) {
+    range.store(Pack(front, back));
+  }
+
+  bool TakeFront(int& chunk) {
+    std::uint64_t current = range.load();
+
+    while (Front(current) < Back(current)) {
+      if (range.compare_exchange_weak(current, Pack(Front(current) + 1, Back(current)))) {
+        chunk = Front(current);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool TakeBack(int& chunk) {
+    std::uint64_t current = range.load();
+
+    while (Front(current) < Back(current)) {
+      if (range.compare_exchange_weak(current, Pack(Front(current), Back(current) - 1))) {
+        chunk = Back(current) - 1;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+private:
+  static std::uint64_t Pack(const int front, const int back) {
+    return (static_cast<std::uint64_t>(back) << 32) | static_cast<std::uint32_t>(front);
+  }
+
+  static int Front(const std::uint64_t value) {
+    return static_cast<int>(value & 0xFFFFFFFFULL);
+  }
+
+  static int Back(const std::uint64_t value) {
+    return static_cast<int>(value >> 32);
+  }
+
+  std::atomic<std::uint64_t> range{ 0 };
+};
+
+// Kept on separate cache lines so workers updating their own totals don't contend.
+struct alignas(64) WorkerTotals {
+  std::array<int, 2> wins{};
+  std::int64_t total_shots_to_win = 0;
+};
+
+TournamentRunner::TournamentRunner(const Configuration& configuration,
+                                   const std::uint64_t master_seed,
+                                   const int thread_count)
+  : configuration(configuration), master_seed(master_seed), thread_count(thread_count) {
+  if (this->thread_count <= 0) {
+    this->thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+}
+
+int TournamentRunner::GetThreadCount() const {
+  return thread_count;
+}
+
+TournamentResult TournamentRunner::Run(const int game_count, const FireMode fire_mode) const {
+  TournamentResult result;
+
+  if (game_count <= 0) {
+    return result;
+  }
+
+  result.games.resize(game_count);
+
+  const int chunk_count = (game_count + games_per_chunk - 1) / games_per_chunk;
+  const int worker_count = std::min(thread_count, chunk_count);
+
+  std::vector<ChunkRange> chunk_ranges(worker_count);
+  std::vector<WorkerTotals> worker_totals(worker_count);
+
+  for (int worker = 0; worker < worker_count; ++worker) {
+    chunk_ranges[worker].Assign((chunk_count * worker) / worker_count,
+                                (chunk_count * (worker + 1)) / worker_count);
+  }
+
+  const auto play_chunks = [&](const int worker) {
+    RandomPlacementGenerator placement_generator(master_seed);
+    GameSimulator game_simulator(configuration, placement_generator);
+    WorkerTotals& totals = worker_totals[worker];
+
+    while (true) {
+      int chunk = -1;
+      bool found = chunk_ranges[worker].TakeFront(chunk);
+
+      for (int offset = 1; !found && (offset < worker_count); ++offset) {
+        found = chunk_ranges[(worker + offset) % worker_count].TakeBack(chunk);
+      }
+
+      if (!found) {
+        break;
+      }
+
+      placement_generator.Seed(MixSeed(master_seed, chunk));
+
+      const int first_game = chunk * games_per_chunk;
+      const int last_game = std::min(game_count, first_game + games_per_chunk);
+
+      // Every game index belongs to exactly one chunk, so workers write disjoint slots.
+      for (int game = first_game; game < last_game; ++game) {
+        const GameStatistics game_statistics = game_simulator.PlayGame(fire_mode);
+
+        if (game_statistics.winner != 0) {
+          ++totals.wins[game_statistics.winner - 1];
+          totals.total_shots_to_win += game_statistics.shots_to_win;
+        }
+
+        result.games[game] = game_statistics;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count - 1);
+
+  for (int worker = 1; worker < worker_count; ++worker) {
+    workers.emplace_back(play_chunks, worker);
+  }
+
+  play_chunks(0);
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (const WorkerTotals& totals : worker_totals) {
+    result.wins[0] += totals.wins[0];
+    result.wins[1] += totals.wins[1];
+    result.total_shots_to_win += totals.total_shots_to_win;
+  }
+
+  return result;
+}
@@ -0,0 +1,43 @@
+#ifndef SRC_SIMULATION_TOURNAMENT_RUNNER_H
+#define SRC_SIMULATION_TOURNAMENT_RUNNER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "configuration/configuration.h"
+#include "fire-mode.h"
+#include "game-simulator.h"
+
+struct TournamentResult {
+  std::vector<GameStatistics> games;
+  // Games in which no fleet could be placed are counted in neither side's wins.
+  std::array<int, 2> wins{};
+  std::int64_t total_shots_to_win = 0;
+};
+
+// Plays many simulated games across a pool of worker threads. Games are split into fixed size
+// chunks and each chunk seeds the worker's own RandomPlacementGenerator from the master seed and
+// the chunk's index, so a tournament is reproducible regardless of the thread count or of which
+// worker ends up playing which chunk. Idle workers steal chunks from the end of busy workers'
+// ranges.
+class TournamentRunner {
+public:
+  static constexpr int games_per_chunk = 64;
+
+  // A thread count of 0 uses one worker per hardware thread.
+  explicit TournamentRunner(const Configuration& configuration,
+                            const std::uint64_t master_seed,
+                            const int thread_count = 0);
+
+  TournamentResult Run(const int game_count, const FireMode fire_mode) const;
+
+  int GetThreadCount() const;
+
+private:
+  const Configuration& configuration;
+  std::uint64_t master_seed;
+  int thread_count;
+};
+
+#endif // SRC_SIMULATION_TOURNAMENT_RUNNER_H
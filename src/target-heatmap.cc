@@ -0,0 +1,196 @@
+#include "target-heatmap.h"
+
+#include <map>
+
+#include "board/window-counts.h"
+
+TargetHeatmap::TargetHeatmap(const Board& board)
+  : board(board),
+    width(board.GetWidth()),
+    height(board.GetHeight()),
+    remaining_ships_count(board.RemainingShipsCount()),
+    heat(board.GetWidth() * board.GetHeight(), 0) {
+  std::map<int, int> remaining_by_size;
+
+  for (const ShipTypeId ship_type_id : board.GetRemainingShipIds()) {
+    ++remaining_by_size[board.GetFleetRegistry().GetSize(ship_type_id)];
+  }
+
+  for (const auto& [size, remaining] : remaining_by_size) {
+    coverages.push_back(ShipLengthCoverage{ size, remaining,
+                                            std::vector<int>(width * height, 0) });
+  }
+
+  for (int x = 1; x <= width; ++x) {
+    for (int y = 1; y <= height; ++y) {
+      if (board.HasShot(Location(x, y))) {
+        recorded_shots.Set(x, y);
+
+        if (!board.IsHit(Location(x, y))) {
+          recorded_misses.Set(x, y);
+        }
+      }
+    }
+  }
+
+  const BitPlane recorded_miss_columns = TransposeBitPlane(recorded_misses, width, height);
+
+  for (ShipLengthCoverage& coverage : coverages) {
+    CountOpenWindows(recorded_misses, recorded_miss_columns, width, height, coverage.size,
+                     coverage.windows);
+
+    for (int index = 0; index < static_cast<int>(heat.size()); ++index) {
+      heat[index] += coverage.windows[index] * coverage.remaining;
+    }
+  }
+}
+
+void TargetHeatmap::RecordShot(const Location location) {
+  if (!board.IsWithinBounds(location) ||
+      !board.HasShot(location) ||
+      recorded_shots.Test(location.x, location.y)) {
+    return;
+  }
+
+  recorded_shots.Set(location.x, location.y);
+
+  if (!board.IsHit(location)) {
+    RecordMiss(location);
+  }
+}
+
+void TargetHeatmap::RecordShots(const std::vector<Location>& locations) {
+  for (const Location location : locations) {
+    RecordShot(location);
+  }
+}
+
+void TargetHeatmap::UpdateRemainingShips() {
+  if (board.RemainingShipsCount() == remaining_ships_count) {
+    return;
+  }
+
+  remaining_ships_count = board.RemainingShipsCount();
+
+  std::map<int, int> remaining_by_size;
+
+  for (const ShipTypeId ship_type_id : board.GetRemainingShipIds()) {
+    ++remaining_by_size[board.GetFleetRegistry().GetSize(ship_type_id)];
+  }
+
+  for (ShipLengthCoverage& coverage : coverages) {
+    const int remaining = remaining_by_size[coverage.size];
+    const int change = remaining - coverage.remaining;
+
+    if (change != 0) {
+      for (int index = 0; index < static_cast<int>(heat.size()); ++index) {
+        heat[index] += change * coverage.windows[index];
+      }
+
+      coverage.remaining = remaining;
+    }
+  }
+}
+
+int TargetHeatmap::GetHeat(const Location location) const {
+  if (!board.IsWithinBounds(location)) {
+    return 0;
+  }
+
+  return heat[CellIndex(location.x, location.y)];
+}
+
+std::vector<Location> TargetHeatmap::HottestLocations() const {
+  return HottestLocations(BitPlane());
+}
+
+std::vector<Location> TargetHeatmap::HottestLocations(const BitPlane& excluded) const {
+  std::vector<Location> locations;
+  int hottest = -1;
+
+  for (int x = 1; x <= width; ++x) {
+    for (int y = 1; y <= height; ++y) {
+      if (board.HasShot(Location(x, y)) || excluded.Test(x, y)) {
+        continue;
+      }
+
+      const int cell_heat = heat[CellIndex(x, y)];
+
+      if (cell_heat > hottest) {
+        hottest = cell_heat;
+        locations.clear();
+      }
+
+      if (cell_heat == hottest) {
+        locations.emplace_back(x, y);
+      }
+    }
+  }
+
+  return locations;
+}
+
+int TargetHeatmap::CellIndex(const int x, const int y) const {
+  return ((y - 1) * width) + (x - 1);
+}
+
+bool TargetHeatmap::IsWindowOpen(const int x, const int y, const int size,
+                                 const Orientation orientation) const {
+  if ((x < 1) || (y < 1)) {
+    return false;
+  }
+
+  if (orientation == Orientation::Horizontal) {
+    if (x + size - 1 > width) {
+      return false;
+    }
+
+    for (int offset = 0; offset < size; ++offset) {
+      if (recorded_misses.Test(x + offset, y)) {
+        return false;
+      }
+    }
+  } else {
+    if (y + size - 1 > height) {
+      return false;
+    }
+
+    for (int offset = 0; offset < size; ++offset) {
+      if (recorded_misses.Test(x, y + offset)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void TargetHeatmap::AddWindow(ShipLengthCoverage& coverage, const int x, const int y,
+                              const Orientation orientation, const int amount) {
+  for (int offset = 0; offset < coverage.size; ++offset) {
+    const int index = (orientation == Orientation::Horizontal) ? CellIndex(x + offset, y)
+                                                               : CellIndex(x, y + offset);
+    coverage.windows[index] += amount;
+    heat[index] += amount * coverage.remaining;
+  }
+}
+
+void TargetHeatmap::RecordMiss(const Location location) {
+  // Only the windows running through the new miss close, and each is checked before the miss is
+  // recorded so that windows already closed by an earlier miss are not removed twice.
+  for (ShipLengthCoverage& coverage : coverages) {
+    for (int offset = 0; offset < coverage.size; ++offset) {
+      if (IsWindowOpen(location.x - offset, location.y, coverage.size,
+                       Orientation::Horizontal)) {
+        AddWindow(coverage, location.x - offset, location.y, Orientation::Horizontal, -1);
+      }
+
+      if ((coverage.size > 1) &&
+          IsWindowOpen(location.x, location.y - offset, coverage.size, Orientation::Vertical)) {
+        AddWindow(coverage, location.x, location.y - offset, Orientation::Vertical, -1);
+      }
+    }
+  }
+
+  recorded_misses.Set(location.x, location.y);
+}
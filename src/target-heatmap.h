@@ -0,0 +1,52 @@
+#ifndef SRC_TARGET_HEATMAP_H
+#define SRC_TARGET_HEATMAP_H
+
+#include <vector>
+
+#include "board/board.h"
+
+// Counts, for every cell of a board, how many positions of the ships still afloat could cover it
+// given the misses seen so far. Each miss only removes the windows passing through it and each
+// sunk ship only removes its own length's windows, so the map is never rebuilt from scratch. The
+// starting windows are counted by CountOpenWindows.
+class TargetHeatmap {
+public:
+  explicit TargetHeatmap(const Board& board);
+
+  // Records a single fired location. Mine chain reactions are recorded by passing
+  // Board::GetLastShotCells to RecordShots.
+  void RecordShot(const Location location);
+  void RecordShots(const std::vector<Location>& locations);
+  void UpdateRemainingShips();
+
+  int GetHeat(const Location location) const;
+  // All not yet fired locations sharing the highest heat.
+  std::vector<Location> HottestLocations() const;
+  // The same, leaving out the locations set in excluded.
+  std::vector<Location> HottestLocations(const BitPlane& excluded) const;
+
+private:
+  struct ShipLengthCoverage {
+    int size;
+    int remaining;
+    // Number of miss-free windows of this length covering each cell.
+    std::vector<int> windows;
+  };
+
+  int CellIndex(const int x, const int y) const;
+  bool IsWindowOpen(const int x, const int y, const int size, const Orientation orientation) const;
+  void AddWindow(ShipLengthCoverage& coverage, const int x, const int y,
+                 const Orientation orientation, const int amount);
+  void RecordMiss(const Location location);
+
+  const Board& board;
+  int width;
+  int height;
+  int remaining_ships_count;
+  std::vector<ShipLengthCoverage> coverages;
+  std::vector<int> heat;
+  BitPlane recorded_shots;
+  BitPlane recorded_misses;
+};
+
+#endif // SRC_TARGET_HEATMAP_H
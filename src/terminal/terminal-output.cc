@@ -0,0 +1,160 @@
+#include "terminal-output.h"
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+std::string_view CursorHome() {
+  return "\033[H";
+}
+
+std::string_view ClearWholeScreen() {
+  return "\033[2J";
+}
+
+std::string_view ClearToEndOfLine() {
+  return "\033[K";
+}
+
+std::string_view ClearToEndOfScreen() {
+  return "\033[J";
+}
+
+// Number of characters a UTF-8 line takes up on screen, counting each code point as one column.
+int DisplayWidth(const std::string_view line) {
+  int width = 0;
+
+  for (const char character : line) {
+    if ((static_cast<unsigned char>(character) & 0xC0) != 0x80) {
+      ++width;
+    }
+  }
+
+  return width;
+}
+
+TerminalOutput::TerminalOutput() {
+  frame.reserve(64 * 1024);
+  update.reserve(64 * 1024);
+}
+
+void TerminalOutput::Clear() {
+  frame.clear();
+}
+
+void TerminalOutput::Write(const std::string_view text) {
+  frame += text;
+}
+
+void TerminalOutput::EchoInput(const std::string_view line) {
+  frame += line;
+  frame += '\n';
+
+  if (screen_lines.empty()) {
+    screen_lines.emplace_back();
+  }
+
+  screen_lines.back() += line;
+  screen_lines.emplace_back();
+}
+
+void TerminalOutput::Flush() {
+  winsize window_size{};
+  int rows = 0;
+  int columns = 0;
+
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window_size) == 0) {
+    rows = window_size.ws_row;
+    columns = window_size.ws_col;
+  }
+
+  const std::string& bytes = ComposeUpdate(rows, columns);
+  std::size_t written = 0;
+
+  while (written < bytes.size()) {
+    const ssize_t result = write(STDOUT_FILENO, bytes.data() + written, bytes.size() - written);
+
+    if (result <= 0) {
+      break;
+    }
+
+    written += result;
+  }
+}
+
+const std::string& TerminalOutput::ComposeUpdate(const int rows, const int columns) {
+  update.clear();
+  SplitFrameLines();
+
+  if (!is_screen_known || !FitsTerminal(rows, columns)) {
+    update += CursorHome();
+    update += ClearWholeScreen();
+    update += frame;
+  } else {
+    for (int line = 0; line < static_cast<int>(frame_lines.size()); ++line) {
+      const bool is_on_screen = (line < static_cast<int>(screen_lines.size())) &&
+                                (screen_lines[line] == frame_lines[line]);
+
+      if (!is_on_screen) {
+        MoveCursor(line + 1, 1);
+        update += frame_lines[line];
+        update += ClearToEndOfLine();
+      }
+    }
+
+    const int last_line = frame_lines.size() - 1;
+
+    if (screen_lines.size() > frame_lines.size()) {
+      MoveCursor(last_line + 2, 1);
+      update += ClearToEndOfScreen();
+    }
+
+    // Input is read where the last line, usually a prompt, ends.
+    MoveCursor(last_line + 1, DisplayWidth(frame_lines[last_line]) + 1);
+  }
+
+  screen_lines.assign(frame_lines.begin(), frame_lines.end());
+  is_screen_known = true;
+
+  return update;
+}
+
+void TerminalOutput::SplitFrameLines() {
+  frame_lines.clear();
+
+  const std::string_view frame_view = frame;
+  std::size_t line_start = 0;
+
+  while (true) {
+    const std::size_t line_end = frame_view.find('\n', line_start);
+
+    if (line_end == std::string_view::npos) {
+      frame_lines.push_back(frame_view.substr(line_start));
+      break;
+    }
+
+    frame_lines.push_back(frame_view.substr(line_start, line_end - line_start));
+    line_start = line_end + 1;
+  }
+}
+
+bool TerminalOutput::FitsTerminal(const int rows, const int columns) const {
+  if (static_cast<int>(frame_lines.size()) > rows) {
+    return false;
+  }
+
+  for (const std::string_view line : frame_lines) {
+    if (DisplayWidth(line) >= columns) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void TerminalOutput::MoveCursor(const int row, const int column) {
+  update += "\033[";
+  update += std::to_string(row);
+  update += ';';
+  update += std::to_string(column);
+  update += 'H';
+}
@@ -0,0 +1,39 @@
+#ifndef SRC_TERMINAL_TERMINAL_OUTPUT_H
+#define SRC_TERMINAL_TERMINAL_OUTPUT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Collects everything printed for the current screen into one buffer and writes it to the terminal
+// in a single call when input is needed. Lines that are already on screen from the previous frame
+// are skipped by moving the cursor over them with ANSI sequences; frames that don't fit the terminal
+// are redrawn in full instead.
+class TerminalOutput {
+public:
+  TerminalOutput();
+
+  // Starts a new frame, replacing whatever is on screen at the next flush.
+  void Clear();
+  void Write(const std::string_view text);
+  // Records a line the user typed, which the terminal has already echoed after the frame.
+  void EchoInput(const std::string_view line);
+  void Flush();
+
+  // Builds the bytes that bring the screen up to date with the current frame on a terminal of the
+  // given size, and assumes they have been written. Returns the update buffer.
+  const std::string& ComposeUpdate(const int rows, const int columns);
+
+private:
+  void SplitFrameLines();
+  bool FitsTerminal(const int rows, const int columns) const;
+  void MoveCursor(const int row, const int column);
+
+  std::string frame;
+  std::string update;
+  std::vector<std::string_view> frame_lines;
+  std::vector<std::string> screen_lines;
+  bool is_screen_known = false;
+};
+
+#endif // SRC_TERMINAL_TERMINAL_OUTPUT_H
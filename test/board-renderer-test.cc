@@ -273,3 +273,76 @@ TEST(BoardRendererTest, MaxBoardSize) {
             "80                                                                                                                                                                                                                                                  \n"
             , render);
 }
+
+TEST(BoardRendererTest, RerenderMatchesFreshRender) {
+  Board board(10, 10);
+  BoardRenderer board_renderer(board);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(A, 2), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(I, 2), Orientation::Vertical);
+  board_renderer.Render();
+
+  board.Shoot(BoardLetterIndex(A, 3));
+  board.Shoot(BoardLetterIndex(J, 10));
+  // A mine under a boat widens its column.
+  board.AddMine(BoardLetterIndex(I, 4));
+  board.AddMine(BoardLetterIndex(E, 5));
+  board.Shoot(BoardLetterIndex(E, 5));
+
+  const std::string render = board_renderer.Render();
+  const BoardRenderer fresh_board_renderer(board);
+
+  EXPECT_EQ(fresh_board_renderer.Render(), render);
+  EXPECT_EQ("   A B C D E F G H I   J\n"
+            "1                       \n"
+            "2  C               D    \n"
+            "3  ●               D    \n"
+            "4  C     X X X     D/M  \n"
+            "5  C     X X X          \n"
+            "6  C     X X X          \n"
+            "7                       \n"
+            "8                       \n"
+            "9                       \n"
+            "10                     X\n", render);
+}
+
+TEST(BoardRendererTest, RerenderAfterModeChangeAndReset) {
+  Board board(5, 5);
+  BoardRenderer board_renderer(board);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.Shoot(BoardLetterIndex(A, 1));
+  board_renderer.Render();
+
+  board_renderer.SetMode(TARGET);
+
+  EXPECT_EQ("  A B C D E\n"
+            "1 ●        \n"
+            "2          \n"
+            "3          \n"
+            "4          \n"
+            "5          \n", board_renderer.Render());
+
+  board_renderer.SetMode(SELF);
+  board.Reset();
+
+  EXPECT_EQ("  A B C D E\n"
+            "1 X        \n"
+            "2          \n"
+            "3          \n"
+            "4          \n"
+            "5          \n", board_renderer.Render());
+}
+
+TEST(BoardRendererTest, RerenderAfterRestore) {
+  Board board(5, 5);
+  BoardRenderer board_renderer(board);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  const std::string render = board_renderer.Render();
+
+  const BoardSnapshot snapshot = board.Snapshot();
+  board.Shoot(BoardLetterIndex(A, 1));
+  board.Shoot(BoardLetterIndex(C, 4));
+  board_renderer.Render();
+  board.Restore(snapshot);
+
+  EXPECT_EQ(render, board_renderer.Render());
+}
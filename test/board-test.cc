@@ -5,7 +5,9 @@
 
 #include "board/auto-placer.h"
 #include "board/board.h"
+#include "board/random-placement-generator.h"
 
+using ::testing::ElementsAre;
 using ::testing::Optional;
 using ::testing::UnorderedElementsAre;
 
@@ -189,30 +191,24 @@ TEST(BoardTest, AutoPlace) {
   EXPECT_EQ(board.GetBoat(BoardLetterIndex(C, 1)), Boat(patrol, Orientation::Vertical));
 }
 
-TEST(BoardTest, AutoPlaceNotEnoughSpaceRetriesButFails) {
-  static constexpr int retries = 10000;
-  static constexpr int boat_count = 2;
-  static constexpr int entries = retries * boat_count;
+TEST(BoardTest, AutoPlaceNotEnoughSpaceFails) {
   Board board(5, 1);
   std::queue<Orientation> orientations;
-  for (int index = 0; index < entries; ++index) {
-    orientations.push(Orientation::Horizontal);
-  }
+  orientations.push(Orientation::Horizontal);
   std::queue<Location> locations;
-  for (int index = 0; index < entries; ++index) {
-    locations.push(BoardLetterIndex(A, 1));
-  }
+  locations.push(BoardLetterIndex(A, 1));
   PredefinedPlacementGenerator placement_generator(board, orientations, locations);
   AutoPlacer auto_placer(board, placement_generator);
   std::vector<ShipType> boats;
   boats.emplace_back(ShipType{ "Battleship", 5 });
   boats.emplace_back(ShipType{ "Carrier", 5 });
 
-  const bool auto_place_success = auto_placer.AutoPlace(boats);
+  const AutoPlaceResult result = auto_placer.Place(boats);
 
-  EXPECT_FALSE(auto_place_success);
-  EXPECT_EQ(orientations.size(), 0);
-  EXPECT_EQ(locations.size(), 0);
+  // The fleet is bigger than the board, so no placement is even attempted.
+  EXPECT_EQ(AutoPlaceResult::Impossible, result);
+  EXPECT_EQ(orientations.size(), 1);
+  EXPECT_EQ(locations.size(), 1);
   EXPECT_EQ(board.GetBoat(BoardLetterIndex(A, 1)), std::nullopt);
   EXPECT_EQ(board.GetBoat(BoardLetterIndex(B, 1)), std::nullopt);
   EXPECT_EQ(board.GetBoat(BoardLetterIndex(C, 1)), std::nullopt);
@@ -220,6 +216,89 @@ TEST(BoardTest, AutoPlaceNotEnoughSpaceRetriesButFails) {
   EXPECT_EQ(board.GetBoat(BoardLetterIndex(E, 1)), std::nullopt);
 }
 
+TEST(BoardTest, AutoPlaceShipsThatCannotFitSideBySideFails) {
+  Board board(5, 2);
+  RandomPlacementGenerator placement_generator;
+  AutoPlacer auto_placer(board, placement_generator);
+  std::vector<ShipType> boats;
+  boats.emplace_back(ShipType{ "Carrier", 3 });
+  boats.emplace_back(ShipType{ "Battleship", 3 });
+  boats.emplace_back(ShipType{ "Destroyer", 3 });
+
+  EXPECT_EQ(AutoPlaceResult::Impossible, auto_placer.Place(boats));
+  EXPECT_EQ(0, board.PlacedBoatsCount());
+}
+
+TEST(BoardTest, AutoPlaceFillsBoardExactly) {
+  Board board(5, 5);
+  RandomPlacementGenerator placement_generator;
+  AutoPlacer auto_placer(board, placement_generator);
+  std::vector<ShipType> boats;
+  boats.emplace_back(ShipType{ "Patrol Boat", 2 });
+  boats.emplace_back(ShipType{ "Carrier", 5 });
+  boats.emplace_back(ShipType{ "Battleship", 5 });
+  boats.emplace_back(ShipType{ "Destroyer", 5 });
+  boats.emplace_back(ShipType{ "Submarine", 5 });
+  boats.emplace_back(ShipType{ "Frigate", 3 });
+
+  const bool auto_place_success = auto_placer.AutoPlace(boats);
+
+  EXPECT_TRUE(auto_place_success);
+  EXPECT_EQ(6, board.PlacedBoatsCount());
+  EXPECT_EQ(boats, board.GetRemainingShips());
+
+  for (int x = 1; x <= 5; ++x) {
+    for (int y = 1; y <= 5; ++y) {
+      EXPECT_TRUE(board.GetBoat(Location(x, y)).has_value());
+    }
+  }
+}
+
+TEST(BoardTest, AutoPlaceKeepsExistingShips) {
+  const ShipType carrier = ShipType{ "Carrier", 5 };
+  Board board(5, 5);
+  board.AddBoat(carrier, BoardLetterIndex(C, 1), Orientation::Vertical);
+  RandomPlacementGenerator placement_generator;
+  AutoPlacer auto_placer(board, placement_generator);
+  std::vector<ShipType> boats;
+  boats.emplace_back(ShipType{ "Battleship", 4 });
+  boats.emplace_back(ShipType{ "Destroyer", 4 });
+  boats.emplace_back(ShipType{ "Submarine", 4 });
+  boats.emplace_back(ShipType{ "Frigate", 4 });
+
+  EXPECT_TRUE(auto_placer.AutoPlace(boats));
+  EXPECT_EQ(5, board.PlacedBoatsCount());
+
+  for (int y = 1; y <= 5; ++y) {
+    EXPECT_EQ(board.GetBoat(BoardLetterIndex(C, y)), Boat(carrier, Orientation::Vertical));
+  }
+}
+
+TEST(BoardTest, AutoPlaceFindsTheOnlyGapAcrossRowWords) {
+  const ShipType carrier = ShipType{ "Carrier", 5 };
+
+  // The gap is cells 63 to 67 of the first line, which straddle the two words of a bit plane row.
+  for (const Orientation orientation : { Orientation::Horizontal, Orientation::Vertical }) {
+    const bool vertical = orientation == Orientation::Vertical;
+    const auto line_location = [vertical](const int line, const int cell) {
+      return vertical ? Location(line, cell) : Location(cell, line);
+    };
+
+    Board board(vertical ? 2 : 70, vertical ? 70 : 2);
+    board.AddBoat(ShipType{ "Wall", 62 }, line_location(1, 1), orientation);
+    board.AddBoat(ShipType{ "End", 3 }, line_location(1, 68), orientation);
+    board.AddBoat(ShipType{ "Second Line", 70 }, line_location(2, 1), orientation);
+    RandomPlacementGenerator placement_generator(1);
+    AutoPlacer auto_placer(board, placement_generator);
+
+    ASSERT_EQ(AutoPlaceResult::Placed, auto_placer.Place({ carrier }));
+
+    for (int cell = 63; cell <= 67; ++cell) {
+      EXPECT_EQ(board.GetBoat(line_location(1, cell)), Boat(carrier, orientation));
+    }
+  }
+}
+
 TEST(BoardTest, ShootTorpedoes) {
   const ShipType cattleship = ShipType{ "Cattleship", 4 };
   const ShipType battleship = ShipType{ "Battleship", 4 };
@@ -323,6 +402,64 @@ TEST(BoardTest, NotFiredLocations) {
                                                         BoardLetterIndex(B, 2)));
 }
 
+TEST(BoardTest, NotFiredPoolShrinksWithShots) {
+  Board board(2, 2);
+  board.AddMine(BoardLetterIndex(A, 1));
+
+  EXPECT_EQ(4, board.NotFiredCount());
+
+  board.Shoot(BoardLetterIndex(B, 2));
+  board.Shoot(BoardLetterIndex(B, 2));
+
+  EXPECT_EQ(3, board.NotFiredCount());
+
+  std::vector<Location> not_fired_locations;
+  for (int index = 0; index < board.NotFiredCount(); ++index) {
+    not_fired_locations.push_back(board.NotFiredLocation(index));
+  }
+
+  EXPECT_THAT(not_fired_locations, UnorderedElementsAre(BoardLetterIndex(A, 1),
+                                                        BoardLetterIndex(A, 2),
+                                                        BoardLetterIndex(B, 1)));
+
+  // The mine takes every remaining cell with it.
+  board.Shoot(BoardLetterIndex(A, 1));
+
+  EXPECT_EQ(0, board.NotFiredCount());
+}
+
+TEST(BoardTest, ShootManyReportsEachOutcome) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 5), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(D, 3));
+
+  // The mine's chain reaction reaches E4 before the volley's own shot at it, and F1 is off the
+  // board.
+  const std::vector<ShotOutcome> outcomes = board.ShootMany(
+      { BoardLetterIndex(A, 1), BoardLetterIndex(B, 1), BoardLetterIndex(A, 5),
+        BoardLetterIndex(C, 2), BoardLetterIndex(D, 3), BoardLetterIndex(E, 4),
+        BoardLetterIndex(F, 1) });
+
+  EXPECT_THAT(outcomes, ElementsAre(ShotOutcome::Hit, ShotOutcome::Sunk, ShotOutcome::Hit,
+                                    ShotOutcome::Miss, ShotOutcome::Mine,
+                                    ShotOutcome::Rejected, ShotOutcome::Rejected));
+  EXPECT_EQ(12, board.GetLastShotCells().size());
+  EXPECT_EQ(BoardLetterIndex(A, 1), board.GetLastShotCells().front());
+  EXPECT_EQ(1, board.RemainingShipsCount());
+}
+
+TEST(BoardTest, ShootManyStopsOnceEveryShipIsSunk) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+
+  const std::vector<ShotOutcome> outcomes = board.ShootMany(
+      { BoardLetterIndex(A, 1), BoardLetterIndex(B, 1), BoardLetterIndex(C, 1) });
+
+  EXPECT_THAT(outcomes, ElementsAre(ShotOutcome::Hit, ShotOutcome::Sunk, ShotOutcome::Rejected));
+  EXPECT_FALSE(board.HasShot(BoardLetterIndex(C, 1)));
+}
+
 TEST(BoardTest, RemainingShips) {
   const ShipType cattleship = ShipType{ "Cattleship", 5 };
   const ShipType battleship = ShipType{ "Battleship", 4 };
@@ -349,5 +486,184 @@ TEST(BoardTest, RemainingShips) {
   EXPECT_THAT(remaining_ships, UnorderedElementsAre(other, patrol));
 }
 
+TEST(BoardTest, RemainingShipsCountTracksSinking) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 3), Orientation::Vertical);
+
+  EXPECT_EQ(2, board.RemainingShipsCount());
+  EXPECT_FALSE(board.AreAllShipsSunk());
+
+  board.Shoot(BoardLetterIndex(A, 3));
+  board.Shoot(BoardLetterIndex(A, 4));
+
+  EXPECT_EQ(1, board.RemainingShipsCount());
+  EXPECT_FALSE(board.AreAllShipsSunk());
+
+  board.Shoot(BoardLetterIndex(A, 1));
+  board.Shoot(BoardLetterIndex(B, 1));
+  board.Shoot(BoardLetterIndex(C, 1));
+
+  EXPECT_EQ(0, board.RemainingShipsCount());
+  EXPECT_TRUE(board.AreAllShipsSunk());
+}
+
+TEST(BoardTest, RemainingShipsFollowMovedShips) {
+  const ShipType patrol = ShipType{ "Patrol Boat", 2 };
+  Board board(5, 5);
+  board.Shoot(BoardLetterIndex(D, 4));
+  board.Shoot(BoardLetterIndex(D, 5));
+  board.AddBoat(patrol, BoardLetterIndex(A, 1), Orientation::Horizontal);
+
+  EXPECT_EQ(1, board.RemainingShipsCount());
+
+  board.MoveBoat(patrol, BoardLetterIndex(D, 4), Orientation::Vertical);
+
+  EXPECT_TRUE(board.AreAllShipsSunk());
+
+  board.Reset();
+
+  EXPECT_EQ(0, board.RemainingShipsCount());
+}
+
 TEST(BoardTest, ShootMineExplodesAdjacentShips) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(B, 2));
+  board.AddMine(BoardLetterIndex(C, 3));
+
+  const bool shot_success = board.Shoot(BoardLetterIndex(C, 3));
+
+  EXPECT_TRUE(shot_success);
+  EXPECT_TRUE(board.IsHit(BoardLetterIndex(A, 1)));
+  EXPECT_TRUE(board.IsHit(BoardLetterIndex(B, 1)));
+  EXPECT_TRUE(board.AreAllShipsSunk());
+  EXPECT_TRUE(board.HasShot(BoardLetterIndex(D, 4)));
+  EXPECT_FALSE(board.HasShot(BoardLetterIndex(E, 5)));
+  EXPECT_EQ(14, board.GetLastShotCells().size());
+}
+
+TEST(BoardTest, LastShotCellsListChainReactionInOrder) {
+  Board board(5, 5);
+  board.AddMine(BoardLetterIndex(B, 2));
+  board.AddMine(BoardLetterIndex(B, 1));
+
+  board.Shoot(BoardLetterIndex(B, 2));
+
+  EXPECT_THAT(board.GetLastShotCells(),
+              ElementsAre(BoardLetterIndex(B, 2), BoardLetterIndex(B, 1), BoardLetterIndex(A, 1),
+                          BoardLetterIndex(C, 1), BoardLetterIndex(A, 2), BoardLetterIndex(C, 2),
+                          BoardLetterIndex(B, 3), BoardLetterIndex(A, 3),
+                          BoardLetterIndex(C, 3)));
+
+  board.Shoot(BoardLetterIndex(B, 2));
+
+  EXPECT_TRUE(board.GetLastShotCells().empty());
+}
+
+TEST(BoardTest, ChainReactionAcrossWholeBoard) {
+  Board board(80, 80);
+
+  for (int x = 1; x <= 80; ++x) {
+    for (int y = 1; y <= 80; ++y) {
+      board.AddMine(Location(x, y));
+    }
+  }
+
+  board.Shoot(Location(40, 40));
+
+  EXPECT_EQ(80 * 80, board.GetLastShotCells().size());
+  EXPECT_EQ(0, board.NotFiredCount());
+}
+
+TEST(BoardTest, RestoreTakesBackShotsSinceSnapshot) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 3), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(D, 4));
+  board.Shoot(BoardLetterIndex(A, 1));
+
+  const BoardSnapshot snapshot = board.Snapshot();
+
+  board.Shoot(BoardLetterIndex(B, 1));
+  board.Shoot(BoardLetterIndex(D, 4));
+
+  ASSERT_EQ(1, board.RemainingShipsCount());
+  ASSERT_EQ(14, board.NotFiredCount());
+
+  board.Restore(snapshot);
+
+  EXPECT_TRUE(board.HasShot(BoardLetterIndex(A, 1)));
+  EXPECT_FALSE(board.HasShot(BoardLetterIndex(B, 1)));
+  EXPECT_FALSE(board.HasShot(BoardLetterIndex(D, 4)));
+  EXPECT_EQ(24, board.NotFiredCount());
+  EXPECT_THAT(board.GetRemainingShips(), ElementsAre(ShipType{ "Patrol Boat", 2 },
+                                                     ShipType{ "Submarine", 3 }));
+  EXPECT_TRUE(board.GetLastShotCells().empty());
+
+  board.Shoot(BoardLetterIndex(B, 1));
+
+  EXPECT_EQ(1, board.RemainingShipsCount());
+  EXPECT_EQ(23, board.NotFiredCount());
+}
+
+TEST(BoardTest, RestoreTakesBackChangedCells) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(D, 4));
+
+  const BoardSnapshot snapshot = board.Snapshot();
+  const std::size_t changed_cell_count = board.GetChangedCells().size();
+  const int reset_count = board.GetResetCount();
+
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    board.Shoot(BoardLetterIndex(A, 1));
+    board.Shoot(BoardLetterIndex(D, 4));
+    board.Restore(snapshot);
+
+    EXPECT_EQ(changed_cell_count, board.GetChangedCells().size());
+  }
+
+  EXPECT_EQ(reset_count + 3, board.GetResetCount());
+
+  // Nothing to take back leaves anything following the changed cells where it was.
+  board.Restore(snapshot);
+
+  EXPECT_EQ(reset_count + 3, board.GetResetCount());
+}
+
+TEST(BoardTest, BoardClampedToMaxSize) {
+  Board board(100, 90);
+
+  const bool placement = board.AddBoat(ShipType{ "Cattleship", 2 }, BoardLetterIndex(CB, 80),
+                                       Orientation::Horizontal);
+  const bool shot_success = board.Shoot(Location(81, 1));
+
+  EXPECT_EQ(80, board.GetWidth());
+  EXPECT_EQ(80, board.GetHeight());
+  EXPECT_FALSE(placement);
+  EXPECT_FALSE(shot_success);
+}
+
+TEST(BoardTest, ShipTypesInternedInConfigurationOrder) {
+  const FleetRegistry fleet_registry({ ShipType{ "Carrier", 5 }, ShipType{ "Submarine", 3 } });
+  Board board(10, 10, fleet_registry);
+
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 3), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(A, 5), Orientation::Horizontal);
+
+  EXPECT_THAT(board.GetShipTypeId(BoardLetterIndex(C, 1)), Optional(ShipTypeId(1)));
+  EXPECT_THAT(board.GetShipTypeId(BoardLetterIndex(B, 3)), Optional(ShipTypeId(2)));
+  EXPECT_THAT(board.GetShipTypeId(BoardLetterIndex(E, 5)), Optional(ShipTypeId(0)));
+  EXPECT_EQ(std::nullopt, board.GetShipTypeId(BoardLetterIndex(A, 2)));
+  EXPECT_EQ("Patrol Boat", board.GetFleetRegistry().GetName(2));
+  EXPECT_EQ(2, fleet_registry.GetCount());
+
+  board.Shoot(BoardLetterIndex(A, 3));
+  board.Shoot(BoardLetterIndex(B, 3));
+
+  EXPECT_THAT(board.GetRemainingShipIds(), ElementsAre(1, 0));
+  EXPECT_THAT(board.GetRemainingShips(), ElementsAre(ShipType{ "Submarine", 3 },
+                                                     ShipType{ "Carrier", 5 }));
 }
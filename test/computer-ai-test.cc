@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
+#include <algorithm>
 #include <queue>
 
-#include "computer-ai.h"
+#include "board/auto-placer.h"
 #include "board-renderer/board-renderer.h"
+#include "computer-ai.h"
+
+using ::testing::ElementsAre;
 
 class CustomPlacementGenerator : public PlacementGenerator {
 private:
@@ -24,7 +29,7 @@ public:
 
   Location ChooseLocation(const std::vector<Location>& choices) override {
     if (locations_to_choose.empty()) {
-      return board.NotFiredLocations().front();
+      return choices.front();
     }
 
     const Location location = locations_to_choose.front();
@@ -98,4 +103,173 @@ TEST(ComputerAiTest, FullGame) {
             "8        X X X X      \n"
             "9                     \n"
             "10 X                 X\n", board_renderer.Render());
-}
\ No newline at end of file
+}
+
+TEST(ComputerAiTest, VolleysPlanDistinctUnfiredLocations) {
+  for (const TargetingMode targeting_mode : { TargetingMode::Random,
+                                              TargetingMode::ProbabilityDensity,
+                                              TargetingMode::MonteCarlo,
+                                              TargetingMode::Parity }) {
+    Board board(6, 6);
+    board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(B, 2), Orientation::Vertical);
+    board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(C, 6), Orientation::Horizontal);
+    board.AddMine(BoardLetterIndex(E, 3));
+    RandomPlacementGenerator placement_generator(3);
+    ComputerAi computer_ai(board, placement_generator);
+    computer_ai.SetTargetingMode(targeting_mode);
+    int volleys = 0;
+
+    while (!board.AreAllShipsSunk()) {
+      const std::vector<Location> volley = computer_ai.ChooseVolley(5);
+
+      ASSERT_EQ(std::min(5, board.NotFiredCount()), volley.size());
+
+      for (int shot = 0; shot < static_cast<int>(volley.size()); ++shot) {
+        EXPECT_FALSE(board.HasShot(volley[shot]));
+        EXPECT_EQ(volley.end(), std::find(volley.begin() + shot + 1, volley.end(), volley[shot]));
+      }
+
+      board.ShootMany(volley);
+      ASSERT_LE(++volleys, 36);
+    }
+  }
+}
+
+TEST(ComputerAiTest, ProbabilityDensityHuntsHottestLocation) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  std::queue<Location> target_locations;
+  CustomPlacementGenerator placement_generator(board, target_locations);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::ProbabilityDensity);
+
+  EXPECT_EQ(BoardLetterIndex(C, 3), computer_ai.ChooseNextShot());
+}
+
+TEST(ComputerAiTest, ProbabilityDensityFullGame) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(F, 2), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Battleship", 4 }, BoardLetterIndex(D, 7), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Patrol", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(E, 6));
+  std::queue<Location> target_locations;
+  CustomPlacementGenerator placement_generator(board, target_locations);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::ProbabilityDensity);
+
+  int shots = 0;
+
+  while (!board.AreAllShipsSunk()) {
+    ASSERT_LT(shots, 100);
+    EXPECT_TRUE(board.Shoot(computer_ai.ChooseNextShot()));
+    ++shots;
+  }
+}
+
+TEST(ComputerAiTest, MonteCarloFullGame) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(F, 2), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Battleship", 4 }, BoardLetterIndex(D, 7), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Patrol", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddMine(BoardLetterIndex(E, 6));
+  RandomPlacementGenerator placement_generator(5);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::MonteCarlo);
+
+  int shots = 0;
+
+  while (!board.AreAllShipsSunk()) {
+    ASSERT_LT(shots, 100);
+    EXPECT_TRUE(board.Shoot(computer_ai.ChooseNextShot()));
+    ++shots;
+  }
+}
+
+TEST(ComputerAiTest, MonteCarloWithoutTimeBudgetStillPlays) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  RandomPlacementGenerator placement_generator(5);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::MonteCarlo);
+  computer_ai.SetMoveTimeBudget(std::chrono::microseconds(0));
+
+  int shots = 0;
+
+  while (!board.AreAllShipsSunk()) {
+    ASSERT_LT(shots, 25);
+    EXPECT_TRUE(board.Shoot(computer_ai.ChooseNextShot()));
+    ++shots;
+  }
+}
+
+TEST(ComputerAiTest, ParityHuntsOnLatticeOfSmallestShip) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(B, 2), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(F, 8), Orientation::Horizontal);
+  RandomPlacementGenerator placement_generator(11);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::Parity);
+
+  while (true) {
+    const Location shot = computer_ai.ChooseNextShot();
+    board.Shoot(shot);
+
+    EXPECT_EQ(0, (shot.x + shot.y) % 3);
+
+    if (board.IsHit(shot)) {
+      break;
+    }
+  }
+}
+
+TEST(ComputerAiTest, ParityExtendsOnlyAlongAlignedHits) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(F, 2), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 10), Orientation::Horizontal);
+  std::queue<Location> target_locations;
+  target_locations.push(BoardLetterIndex(F, 4));
+  CustomPlacementGenerator placement_generator(board, target_locations);
+  ComputerAi computer_ai(board, placement_generator);
+  computer_ai.SetTargetingMode(TargetingMode::Parity);
+  std::vector<Location> shots;
+
+  while (board.RemainingShipsCount() == 2) {
+    shots.push_back(computer_ai.ChooseNextShot());
+    ASSERT_TRUE(board.Shoot(shots.back()));
+  }
+
+  // Above F4 first, and then the ends of the line F3-F4 until the carrier sinks.
+  EXPECT_THAT(shots, ElementsAre(BoardLetterIndex(F, 4), BoardLetterIndex(F, 3),
+                                 BoardLetterIndex(F, 2), BoardLetterIndex(F, 1),
+                                 BoardLetterIndex(F, 5), BoardLetterIndex(F, 6)));
+
+  // With the carrier's hits put down to it, the hunt resumes on the lattice.
+  const Location next_shot = computer_ai.ChooseNextShot();
+  EXPECT_EQ(0, (next_shot.x + next_shot.y) % 2);
+}
+
+TEST(ComputerAiTest, ParityNeedsFewerShotsThanRandom) {
+  const std::vector<ShipType> fleet = { ShipType{ "Carrier", 5 }, ShipType{ "Battleship", 4 },
+                                        ShipType{ "Destroyer", 3 }, ShipType{ "Submarine", 3 },
+                                        ShipType{ "Patrol Boat", 2 } };
+  std::array<int, 2> total_shots{};
+
+  for (int game = 0; game < 50; ++game) {
+    for (const TargetingMode targeting_mode : { TargetingMode::Random, TargetingMode::Parity }) {
+      RandomPlacementGenerator placement_generator(game);
+      Board board(10, 10);
+      AutoPlacer auto_placer(board, placement_generator);
+      ASSERT_TRUE(auto_placer.AutoPlace(fleet));
+      ComputerAi computer_ai(board, placement_generator);
+      computer_ai.SetTargetingMode(targeting_mode);
+      int& shots = total_shots[targeting_mode == TargetingMode::Parity];
+
+      while (!board.AreAllShipsSunk()) {
+        ASSERT_TRUE(board.Shoot(computer_ai.ChooseNextShot()));
+        ++shots;
+      }
+    }
+  }
+
+  EXPECT_LT(total_shots[1], total_shots[0]);
+}
@@ -181,3 +181,64 @@ TEST(ConfigurationParserTest, NoShipsDetected) {
   EXPECT_THAT(parser.GetErrors(),
               Contains(ConfigurationError::NoShips));
 }
+
+TEST(ConfigurationParserTest, ErrorPositionsPointAtEntries) {
+  const std::string configuration_string =
+      "Board: 20x20\n"
+      "Boat: Carrier, 5\n"
+      "  Boat: Destroyer, 21\n";
+  ConfigurationParser parser = ConfigurationParser(configuration_string);
+
+  parser.Parse();
+
+  ASSERT_EQ(1, parser.GetErrorPositions().size());
+  EXPECT_EQ(ConfigurationError::ShipTooBig, parser.GetErrorPositions()[0].error);
+  EXPECT_EQ(3, parser.GetErrorPositions()[0].line);
+  EXPECT_EQ(3, parser.GetErrorPositions()[0].column);
+}
+
+TEST(ConfigurationParserTest, MissingEntriesHaveNoPosition) {
+  const std::string configuration_string = "Nothing to see here\n";
+  ConfigurationParser parser = ConfigurationParser(configuration_string);
+
+  parser.Parse();
+
+  ASSERT_EQ(2, parser.GetErrorPositions().size());
+  EXPECT_EQ(ConfigurationError::BoardSizeNotSpecified, parser.GetErrorPositions()[0].error);
+  EXPECT_EQ(0, parser.GetErrorPositions()[0].line);
+  EXPECT_EQ(ConfigurationError::NoShips, parser.GetErrorPositions()[1].error);
+  EXPECT_EQ(0, parser.GetErrorPositions()[1].column);
+}
+
+TEST(ConfigurationParserTest, EntriesWithoutNumbersIgnored) {
+  const std::string configuration_string =
+      "Board: x20\n"
+      "Board: 20x15\n"
+      "Boat: Carrier, \n"
+      "Boat: Battleship, 4\n";
+  ConfigurationParser parser = ConfigurationParser(configuration_string);
+
+  Configuration configuration = parser.Parse();
+
+  EXPECT_EQ(20, configuration.board_width);
+  EXPECT_EQ(15, configuration.board_height);
+  EXPECT_THAT(configuration.ship_types, UnorderedElementsAre(ShipType{ "Battleship", 4 }));
+  EXPECT_TRUE(parser.GetErrors().empty());
+}
+
+TEST(ConfigurationParserTest, SeedParsedWhenGiven) {
+  const std::string configuration_string =
+      "Board: 10x10\n"
+      "Seed: 1234567890123456789\n"
+      "Boat: Carrier, 5\n";
+  ConfigurationParser parser = ConfigurationParser(configuration_string);
+
+  Configuration configuration = parser.Parse();
+
+  ASSERT_TRUE(configuration.seed.has_value());
+  EXPECT_EQ(1234567890123456789u, *configuration.seed);
+  EXPECT_THAT(configuration.ship_types, UnorderedElementsAre(ShipType{ "Carrier", 5 }));
+  EXPECT_TRUE(parser.GetErrors().empty());
+
+  EXPECT_FALSE(ConfigurationParser("Board: 10x10\nBoat: Carrier, 5\n").Parse().seed.has_value());
+}
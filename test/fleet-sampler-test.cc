@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "board/random-placement-generator.h"
+#include "fleet-sampler.h"
+
+std::chrono::steady_clock::time_point SamplingDeadline() {
+  return std::chrono::steady_clock::now() + std::chrono::seconds(5);
+}
+
+TEST(FleetSamplerTest, FillsPoolWithLayoutsAvoidingMisses) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(A, 1), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(C, 5), Orientation::Horizontal);
+  RandomPlacementGenerator placement_generator(7);
+  FleetSampler fleet_sampler(board, placement_generator);
+
+  board.Shoot(BoardLetterIndex(E, 5));
+  board.Shoot(BoardLetterIndex(J, 10));
+  fleet_sampler.Update(SamplingDeadline());
+
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.SampleCount());
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.GetOccupancy(BoardLetterIndex(E, 5)));
+  EXPECT_EQ(0, fleet_sampler.GetOccupancy(BoardLetterIndex(J, 10)));
+}
+
+TEST(FleetSamplerTest, DropsLayoutsContradictedByLaterShots) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(C, 5), Orientation::Horizontal);
+  RandomPlacementGenerator placement_generator(7);
+  FleetSampler fleet_sampler(board, placement_generator);
+
+  board.Shoot(BoardLetterIndex(D, 5));
+  fleet_sampler.Update(SamplingDeadline());
+
+  ASSERT_GT(fleet_sampler.GetOccupancy(BoardLetterIndex(D, 6)), 0);
+
+  board.Shoot(BoardLetterIndex(D, 6));
+  board.Shoot(BoardLetterIndex(D, 4));
+  board.Shoot(BoardLetterIndex(C, 5));
+  fleet_sampler.Update(SamplingDeadline());
+
+  // Only B5-D5 and C5-E5 cover both hits now.
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.SampleCount());
+  EXPECT_EQ(0, fleet_sampler.GetOccupancy(BoardLetterIndex(D, 6)));
+  EXPECT_EQ(0, fleet_sampler.GetOccupancy(BoardLetterIndex(A, 5)));
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.GetOccupancy(BoardLetterIndex(C, 5)));
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.GetOccupancy(BoardLetterIndex(B, 5)) +
+                                       fleet_sampler.GetOccupancy(BoardLetterIndex(E, 5)));
+}
+
+TEST(FleetSamplerTest, SunkShipsOnlyLieOnHits) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(C, 3), Orientation::Vertical);
+  RandomPlacementGenerator placement_generator(3);
+  FleetSampler fleet_sampler(board, placement_generator);
+
+  board.Shoot(BoardLetterIndex(A, 1));
+  board.Shoot(BoardLetterIndex(B, 1));
+  fleet_sampler.Update(SamplingDeadline());
+
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.SampleCount());
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.GetOccupancy(BoardLetterIndex(A, 1)));
+  EXPECT_EQ(FleetSampler::max_samples, fleet_sampler.GetOccupancy(BoardLetterIndex(B, 1)));
+  EXPECT_LT(fleet_sampler.GetOccupancy(BoardLetterIndex(C, 1)), FleetSampler::max_samples);
+}
+
+TEST(FleetSamplerTest, NoTimeBudgetGivesNoLayouts) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(C, 5), Orientation::Horizontal);
+  RandomPlacementGenerator placement_generator(7);
+  FleetSampler fleet_sampler(board, placement_generator);
+
+  fleet_sampler.Update(std::chrono::steady_clock::now());
+
+  EXPECT_EQ(0, fleet_sampler.SampleCount());
+  EXPECT_TRUE(fleet_sampler.MostOccupiedLocations().empty());
+}
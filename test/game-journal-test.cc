@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <unistd.h>
+
+#include "board/auto-placer.h"
+#include "board/random-placement-generator.h"
+#include "computer-ai.h"
+#include "journal/game-journal.h"
+#include "journal/journal-reader.h"
+#include "test-configurations.h"
+
+std::string TestJournalPath(const std::string& name) {
+  return "/tmp/game-journal-test-" + std::to_string(getpid()) + "-" + name + ".journal";
+}
+
+// Plays a computer vs computer game with hidden mines, recording it as it goes.
+GameRecord RecordGame(const Configuration& configuration, const std::uint64_t seed) {
+  RandomPlacementGenerator placement_generator(seed);
+  Board board_1(configuration.board_width, configuration.board_height);
+  Board board_2(configuration.board_width, configuration.board_height);
+
+  for (Board* board : { &board_1, &board_2 }) {
+    board->AddRandomMines(placement_generator);
+    AutoPlacer(*board, placement_generator).AutoPlace(configuration.ship_types);
+  }
+
+  ComputerAi computer_1_ai(board_2, placement_generator);
+  ComputerAi computer_2_ai(board_1, placement_generator);
+  GameRecorder game_recorder;
+  game_recorder.Begin(configuration, seed, RandomEngine::MersenneTwister, HIDDEN_MINES, board_1,
+                      board_2);
+
+  int winner = 0;
+
+  while (winner == 0) {
+    const Location shot_1 = computer_1_ai.ChooseNextShot();
+
+    if (board_2.Shoot(shot_1)) {
+      game_recorder.RecordShot(board_2, shot_1);
+    }
+
+    if (board_2.AreAllShipsSunk()) {
+      winner = 1;
+      break;
+    }
+
+    const Location shot_2 = computer_2_ai.ChooseNextShot();
+
+    if (board_1.Shoot(shot_2)) {
+      game_recorder.RecordShot(board_1, shot_2);
+    }
+
+    if (board_1.AreAllShipsSunk()) {
+      winner = 2;
+    }
+  }
+
+  game_recorder.Finish(winner);
+
+  return game_recorder.GetRecord();
+}
+
+void ExpectSameRecord(const GameRecord& expected, const GameRecord& actual) {
+  EXPECT_EQ(expected.summary.configuration_hash, actual.summary.configuration_hash);
+  EXPECT_EQ(expected.summary.seed, actual.summary.seed);
+  EXPECT_EQ(expected.summary.random_engine, actual.summary.random_engine);
+  EXPECT_EQ(expected.summary.fire_mode, actual.summary.fire_mode);
+  EXPECT_EQ(expected.summary.winner, actual.summary.winner);
+  EXPECT_EQ(expected.summary.shot_count, actual.summary.shot_count);
+
+  for (int board = 0; board < 2; ++board) {
+    ASSERT_EQ(expected.boats[board].size(), actual.boats[board].size());
+
+    for (int boat = 0; boat < static_cast<int>(expected.boats[board].size()); ++boat) {
+      EXPECT_EQ(expected.boats[board][boat].ship_type, actual.boats[board][boat].ship_type);
+      EXPECT_EQ(expected.boats[board][boat].start_location,
+                actual.boats[board][boat].start_location);
+      EXPECT_EQ(expected.boats[board][boat].orientation, actual.boats[board][boat].orientation);
+    }
+
+    EXPECT_EQ(expected.mines[board], actual.mines[board]);
+  }
+
+  ASSERT_EQ(expected.shots.size(), actual.shots.size());
+
+  for (int shot = 0; shot < static_cast<int>(expected.shots.size()); ++shot) {
+    EXPECT_EQ(expected.shots[shot].board, actual.shots[shot].board);
+    EXPECT_EQ(expected.shots[shot].location, actual.shots[shot].location);
+    EXPECT_EQ(expected.shots[shot].result, actual.shots[shot].result);
+  }
+}
+
+TEST(GameJournalTest, RecordsRoundTrip) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const GameRecord record = RecordGame(configuration, 3);
+
+  ASSERT_NE(0, record.summary.winner);
+  EXPECT_EQ(5, record.boats[0].size());
+  EXPECT_EQ(5, record.mines[1].size());
+
+  std::string bytes;
+  EncodeGameRecord(record, bytes);
+
+  GameRecord decoded;
+  ASSERT_TRUE(DecodeGameRecord(bytes, configuration.ship_types.size(), decoded));
+  ExpectSameRecord(record, decoded);
+
+  // At most two bytes per shot on a 10x10 board, plus the boards.
+  EXPECT_LT(bytes.size(), (2 * record.shots.size()) + 64);
+
+  GameSummary summary;
+  ASSERT_TRUE(DecodeGameSummary(bytes, summary));
+  EXPECT_EQ(record.summary.shot_count, summary.shot_count);
+
+  EXPECT_FALSE(DecodeGameRecord(std::string_view(bytes).substr(0, bytes.size() - 1),
+                                configuration.ship_types.size(), decoded));
+  // A record naming ship types the configuration doesn't have is as damaged as a short one.
+  EXPECT_FALSE(DecodeGameRecord(bytes, configuration.ship_types.size() - 1, decoded));
+}
+
+TEST(GameJournalTest, ConfigurationHashChangesWithTheFleet) {
+  Configuration configuration = DefaultTestConfiguration();
+  const std::uint64_t hash = ConfigurationHash(configuration);
+
+  EXPECT_EQ(hash, ConfigurationHash(DefaultTestConfiguration()));
+
+  configuration.ship_types.back().size = 3;
+  EXPECT_NE(hash, ConfigurationHash(configuration));
+}
+
+TEST(GameJournalTest, ReaderFindsEveryAppendedGame) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const std::string path = TestJournalPath("append");
+  std::vector<GameRecord> records;
+
+  for (int seed = 1; seed <= 3; ++seed) {
+    records.push_back(RecordGame(configuration, seed));
+  }
+
+  {
+    GameJournal game_journal(path);
+    ASSERT_TRUE(game_journal.IsOpen());
+    EXPECT_TRUE(game_journal.Append(records[0]));
+  }
+
+  {
+    // Reopening appends to the games already there.
+    GameJournal game_journal(path);
+    EXPECT_TRUE(game_journal.Append(records[1]));
+    EXPECT_TRUE(game_journal.Append(records[2]));
+  }
+
+  const JournalReader journal_reader(path);
+  ASSERT_TRUE(journal_reader.IsOpen());
+  ASSERT_EQ(3, journal_reader.GetGameCount());
+  EXPECT_FALSE(journal_reader.HasTruncatedRecord());
+
+  GameRecord record;
+
+  for (int game = 0; game < 3; ++game) {
+    ASSERT_TRUE(journal_reader.ReadGame(game, configuration.ship_types.size(), record));
+    ExpectSameRecord(records[game], record);
+  }
+
+  EXPECT_FALSE(journal_reader.ReadGame(3, configuration.ship_types.size(), record));
+
+  unlink(path.c_str());
+}
+
+TEST(GameJournalTest, ReaderSkipsARecordCutShort) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const std::string path = TestJournalPath("truncated");
+
+  {
+    GameJournal game_journal(path);
+    game_journal.Append(RecordGame(configuration, 1));
+    game_journal.Append(RecordGame(configuration, 2));
+  }
+
+  std::ifstream input(path, std::ios::binary);
+  const std::string bytes((std::istreambuf_iterator<char>(input)),
+                          std::istreambuf_iterator<char>());
+  input.close();
+
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 5);
+
+  const JournalReader journal_reader(path);
+  ASSERT_TRUE(journal_reader.IsOpen());
+  EXPECT_EQ(1, journal_reader.GetGameCount());
+  EXPECT_TRUE(journal_reader.HasTruncatedRecord());
+
+  GameSummary summary;
+  EXPECT_TRUE(journal_reader.ReadSummary(0, summary));
+  EXPECT_EQ(1, summary.seed);
+
+  unlink(path.c_str());
+}
+
+TEST(GameJournalTest, ReplayingShotsReproducesTheGame) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const GameRecord record = RecordGame(configuration, 5);
+
+  std::array<Board, 2> boards{ Board(10, 10), Board(10, 10) };
+
+  for (int board = 0; board < 2; ++board) {
+    for (const JournalBoat& boat : record.boats[board]) {
+      ASSERT_TRUE(boards[board].AddBoat(configuration.ship_types.at(boat.ship_type),
+                                        boat.start_location, boat.orientation));
+    }
+
+    for (const Location mine : record.mines[board]) {
+      boards[board].AddMine(mine);
+    }
+  }
+
+  for (const JournalShot& shot : record.shots) {
+    ASSERT_TRUE(boards[shot.board].Shoot(shot.location));
+    EXPECT_EQ(shot.result, RecordedShotResult(boards[shot.board], shot.location));
+  }
+
+  EXPECT_TRUE(boards[2 - record.summary.winner].AreAllShipsSunk());
+}
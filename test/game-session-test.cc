@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "server/game-session.h"
+#include "test-configurations.h"
+
+TEST(GameSessionTest, ListsShipsAndPlacesThem) {
+  const Configuration configuration = DefaultTestConfiguration();
+  GameSession game_session(configuration, 1);
+
+  EXPECT_EQ("OK\n", game_session.HandleLine("place 1 h A1"));
+  EXPECT_EQ("ERR ship already placed\n", game_session.HandleLine("PLACE 1 v C3"));
+  EXPECT_EQ("ERR ship does not fit there\n", game_session.HandleLine("PLACE 2 h A1"));
+  EXPECT_EQ("ERR unknown ship\n", game_session.HandleLine("PLACE 6 h A3"));
+  EXPECT_EQ("ERR invalid location\n", game_session.HandleLine("PLACE 2 h 3"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("PLACE 2 v 3c\r"));
+
+  EXPECT_EQ("1 5 placed Carrier\n"
+            "2 4 placed Battleship\n"
+            "3 3 unplaced Destroyer\n"
+            "4 3 unplaced Submarine\n"
+            "5 2 unplaced Patrol Boat\n"
+            "OK\n",
+            game_session.HandleLine("SHIPS"));
+}
+
+TEST(GameSessionTest, StartsOnlyOnceTheFleetIsPlaced) {
+  const Configuration configuration = DefaultTestConfiguration();
+  GameSession game_session(configuration, 1);
+
+  EXPECT_EQ("ERR the game is not in progress\n", game_session.HandleLine("FIRE A1"));
+  EXPECT_EQ("ERR not every ship is placed\n", game_session.HandleLine("START"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("AUTO"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("START"));
+  EXPECT_EQ(SessionState::Playing, game_session.GetState());
+  EXPECT_EQ("ERR ships can only be placed before the game starts\n",
+            game_session.HandleLine("RESET"));
+}
+
+TEST(GameSessionTest, FiringAnswersWithBothShots) {
+  const Configuration configuration = DefaultTestConfiguration();
+  GameSession game_session(configuration, 1);
+
+  game_session.HandleLine("AUTO");
+  game_session.HandleLine("START");
+
+  const std::string reply = game_session.HandleLine("FIRE b2");
+
+  EXPECT_EQ(0, reply.rfind("SHOT B2 ", 0));
+  EXPECT_NE(std::string::npos, reply.find("\nINCOMING "));
+  EXPECT_EQ("ERR invalid shot\n", game_session.HandleLine("FIRE B2"));
+}
+
+TEST(GameSessionTest, PlaysAWholeGame) {
+  const Configuration configuration = DefaultTestConfiguration();
+  GameSession game_session(configuration, 7);
+
+  ASSERT_EQ("OK\n", game_session.HandleLine("NEW salvo"));
+  game_session.HandleLine("AUTO");
+  ASSERT_EQ("OK\n", game_session.HandleLine("START"));
+
+  for (int x = 1; (x <= 10) && (game_session.GetState() == SessionState::Playing); ++x) {
+    for (int y = 1; (y <= 10) && (game_session.GetState() == SessionState::Playing); ++y) {
+      const std::string reply = game_session.HandleLine("FIRE " + Location(x, y).ToString());
+
+      ASSERT_EQ("OK\n", reply.substr(reply.size() - 3));
+    }
+  }
+
+  EXPECT_EQ(SessionState::Finished, game_session.GetState());
+  EXPECT_EQ("ERR the game is not in progress\n", game_session.HandleLine("FIRE A1"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("NEW"));
+  EXPECT_EQ(SessionState::Placing, game_session.GetState());
+}
+
+TEST(GameSessionTest, NewChoosesTheComputersTargeting) {
+  const Configuration configuration = DefaultTestConfiguration();
+
+  for (const char* const targeting : { "random", "density", "MonteCarlo", "parity" }) {
+    GameSession game_session(configuration, 3);
+
+    ASSERT_EQ("OK\n", game_session.HandleLine(std::string("NEW normal ") + targeting));
+    game_session.HandleLine("AUTO");
+    ASSERT_EQ("OK\n", game_session.HandleLine("START"));
+
+    for (int x = 1; (x <= 10) && (game_session.GetState() == SessionState::Playing); ++x) {
+      for (int y = 1; (y <= 10) && (game_session.GetState() == SessionState::Playing); ++y) {
+        const std::string reply = game_session.HandleLine("FIRE " + Location(x, y).ToString());
+
+        ASSERT_EQ("OK\n", reply.substr(reply.size() - 3));
+      }
+    }
+
+    EXPECT_EQ(SessionState::Finished, game_session.GetState());
+  }
+
+  GameSession game_session(configuration, 3);
+
+  EXPECT_EQ("ERR unknown targeting\n", game_session.HandleLine("NEW salvo sonar"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("NEW salvo"));
+}
+
+TEST(GameSessionTest, QuitClosesTheSession) {
+  const Configuration configuration = DefaultTestConfiguration();
+  GameSession game_session(configuration, 1);
+
+  EXPECT_EQ("ERR unknown command\n", game_session.HandleLine("HELLO"));
+  EXPECT_EQ("OK\n", game_session.HandleLine("quit"));
+  EXPECT_TRUE(game_session.IsClosed());
+  EXPECT_EQ("ERR session closed\n", game_session.HandleLine("SHIPS"));
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "board/random-placement-generator.h"
+#include "simulation/game-simulator.h"
+#include "test-configurations.h"
+
+TEST(GameSimulatorTest, NormalGamesHaveAWinner) {
+  const Configuration configuration = DefaultTestConfiguration();
+  RandomPlacementGenerator placement_generator;
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  const std::vector<GameStatistics> games = game_simulator.PlayGames(20, NORMAL);
+
+  ASSERT_EQ(20, games.size());
+
+  for (const GameStatistics& game : games) {
+    ASSERT_TRUE((game.winner == 1) || (game.winner == 2));
+
+    const PlayerStatistics& winner = game.players[game.winner - 1];
+    EXPECT_EQ(winner.shots, game.shots_to_win);
+    // Every cell of the fleet has to be hit before a game can be won.
+    EXPECT_EQ(17, winner.hits);
+    EXPECT_GE(winner.shots, winner.hits);
+    EXPECT_LE(winner.shots, 100);
+    EXPECT_EQ(0, game.players[0].mine_triggers);
+    EXPECT_EQ(0, game.players[1].mine_triggers);
+  }
+}
+
+TEST(GameSimulatorTest, SalvoGamesFireMoreShotsPerTurn) {
+  const Configuration configuration = DefaultTestConfiguration();
+  RandomPlacementGenerator placement_generator;
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  const GameStatistics game = game_simulator.PlayGame(SALVO);
+
+  ASSERT_NE(0, game.winner);
+  EXPECT_GT(game.players[0].shots, game.turns);
+}
+
+TEST(GameSimulatorTest, HiddenMinesGamesTriggerMines) {
+  const Configuration configuration = DefaultTestConfiguration();
+  RandomPlacementGenerator placement_generator;
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  int mine_triggers = 0;
+
+  for (const GameStatistics& game : game_simulator.PlayGames(20, HIDDEN_MINES)) {
+    ASSERT_NE(0, game.winner);
+    mine_triggers += game.players[0].mine_triggers + game.players[1].mine_triggers;
+  }
+
+  EXPECT_GT(mine_triggers, 0);
+}
+
+TEST(GameSimulatorTest, UnplaceableFleetPlaysNoGame) {
+  Configuration configuration;
+  configuration.board_width = 5;
+  configuration.board_height = 5;
+  configuration.ship_types.emplace_back(ShipType{ "Carrier", 6 });
+  RandomPlacementGenerator placement_generator;
+  GameSimulator game_simulator(configuration, placement_generator);
+
+  const GameStatistics game = game_simulator.PlayGame(NORMAL);
+
+  EXPECT_EQ(0, game.winner);
+  EXPECT_EQ(0, game.turns);
+}
+
+TEST(GameSimulatorTest, FixedBoardGamesMatchBoardGames) {
+  const Configuration configuration = DefaultTestConfiguration();
+
+  for (const FireMode fire_mode : { NORMAL, SALVO, HIDDEN_MINES }) {
+    RandomPlacementGenerator fixed_board_generator(7);
+    RandomPlacementGenerator board_generator(7);
+    // Passed as a PlacementGenerator, so the simulator can't take the FixedBoard path.
+    PlacementGenerator& board_placement_generator = board_generator;
+    GameSimulator fixed_board_simulator(configuration, fixed_board_generator);
+    GameSimulator board_simulator(configuration, board_placement_generator);
+
+    const std::vector<GameStatistics> fixed_board_games =
+        fixed_board_simulator.PlayGames(20, fire_mode);
+    const std::vector<GameStatistics> board_games = board_simulator.PlayGames(20, fire_mode);
+
+    ASSERT_EQ(board_games.size(), fixed_board_games.size());
+
+    for (size_t game = 0; game < board_games.size(); ++game) {
+      EXPECT_EQ(board_games[game].winner, fixed_board_games[game].winner);
+      EXPECT_EQ(board_games[game].turns, fixed_board_games[game].turns);
+      EXPECT_EQ(board_games[game].shots_to_win, fixed_board_games[game].shots_to_win);
+
+      for (int player = 0; player < 2; ++player) {
+        const PlayerStatistics& board_player = board_games[game].players[player];
+        const PlayerStatistics& fixed_board_player = fixed_board_games[game].players[player];
+        EXPECT_EQ(board_player.shots, fixed_board_player.shots);
+        EXPECT_EQ(board_player.hits, fixed_board_player.hits);
+        EXPECT_EQ(board_player.mine_triggers, fixed_board_player.mine_triggers);
+      }
+    }
+  }
+}
+
+TEST(GameSimulatorTest, MonteCarloGamesRepeatForTheSameSeed) {
+  const Configuration configuration = DefaultTestConfiguration();
+  std::array<std::vector<GameStatistics>, 2> runs;
+
+  for (std::vector<GameStatistics>& games : runs) {
+    RandomPlacementGenerator placement_generator(7);
+    GameSimulator game_simulator(configuration, placement_generator);
+    game_simulator.SetTargetingMode(1, TargetingMode::MonteCarlo);
+    games = game_simulator.PlayGames(3, NORMAL);
+  }
+
+  ASSERT_EQ(runs[0].size(), runs[1].size());
+
+  for (size_t game = 0; game < runs[0].size(); ++game) {
+    EXPECT_EQ(runs[0][game].winner, runs[1][game].winner);
+    EXPECT_EQ(runs[0][game].players[0].shots, runs[1][game].players[0].shots);
+    EXPECT_EQ(runs[0][game].players[1].shots, runs[1][game].players[1].shots);
+  }
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "profiling/profiler.h"
+
+TEST(ProfilerTest, MergesEveryThreadsSamples) {
+  ResetProfiles();
+
+  RecordProfileSample(ProfilePoint::BoardShoot, 100);
+
+  std::thread worker([] {
+    for (int sample = 0; sample < 9; ++sample) {
+      RecordProfileSample(ProfilePoint::BoardShoot, 3000);
+    }
+
+    RecordProfileSample(ProfilePoint::AutoPlacerAutoPlace, 5);
+  });
+  worker.join();
+
+  // The worker has exited, so its counts come from the retired totals.
+  const ProfileReport report = MergeProfiles();
+  const ProfileTotals& shoot = report[static_cast<int>(ProfilePoint::BoardShoot)];
+
+  EXPECT_EQ(10, shoot.calls);
+  EXPECT_EQ(27100, shoot.total_nanoseconds);
+  EXPECT_EQ(3000, shoot.max_nanoseconds);
+  EXPECT_EQ(1, report[static_cast<int>(ProfilePoint::AutoPlacerAutoPlace)].calls);
+  EXPECT_EQ(0, report[static_cast<int>(ProfilePoint::BoardRendererRender)].calls);
+
+  ResetProfiles();
+  EXPECT_EQ(0, MergeProfiles()[static_cast<int>(ProfilePoint::BoardShoot)].calls);
+}
+
+TEST(ProfilerTest, PercentilesComeFromTheHistogram) {
+  ResetProfiles();
+
+  for (int sample = 0; sample < 90; ++sample) {
+    RecordProfileSample(ProfilePoint::ComputerAiChooseNextShot, 100);
+  }
+
+  for (int sample = 0; sample < 10; ++sample) {
+    RecordProfileSample(ProfilePoint::ComputerAiChooseNextShot, 5000);
+  }
+
+  const ProfileReport report = MergeProfiles();
+  const ProfileTotals& totals = report[static_cast<int>(ProfilePoint::ComputerAiChooseNextShot)];
+
+  // 100 falls in the bucket of 64 to 127 and 5000 in that of 4096 to 8191, capped at the maximum.
+  EXPECT_EQ(127, totals.Percentile(0.5));
+  EXPECT_EQ(5000, totals.Percentile(0.99));
+
+  const std::string text = FormatProfileReport(report);
+  EXPECT_NE(std::string::npos, text.find("ComputerAi::ChooseNextShot"));
+  EXPECT_EQ(std::string::npos, text.find("Board::Shoot"));
+
+  ResetProfiles();
+}
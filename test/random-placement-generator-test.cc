@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "board/philox-engine.h"
+#include "board/random-placement-generator.h"
+
+using ::testing::ElementsAre;
+
+std::vector<int> DrawIndexes(RandomPlacementGenerator& placement_generator, const int count) {
+  std::vector<int> indexes;
+
+  for (int draw = 0; draw < count; ++draw) {
+    indexes.push_back(placement_generator.ChooseIndex(1000));
+  }
+
+  return indexes;
+}
+
+// The known answer tests published with Random123.
+TEST(RandomPlacementGeneratorTest, PhiloxMatchesKnownAnswers) {
+  EXPECT_THAT(PhiloxEngine::GenerateBlock({ 0, 0, 0, 0 }, { 0, 0 }),
+              ElementsAre(0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8));
+  EXPECT_THAT(PhiloxEngine::GenerateBlock({ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF },
+                                          { 0xFFFFFFFF, 0xFFFFFFFF }),
+              ElementsAre(0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD));
+  EXPECT_THAT(PhiloxEngine::GenerateBlock({ 0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344 },
+                                          { 0xA4093822, 0x299F31D0 }),
+              ElementsAre(0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1));
+}
+
+// Pins the numbers drawn for a seed, which must not change between platforms or releases for
+// journaled seeds to keep dealing the same games.
+TEST(RandomPlacementGeneratorTest, SeedsGiveTheSameNumbersEverywhere) {
+  RandomPlacementGenerator mersenne_twister(2024, RandomEngine::MersenneTwister);
+  RandomPlacementGenerator philox(2024, RandomEngine::Philox);
+
+  EXPECT_THAT(DrawIndexes(mersenne_twister, 8), ElementsAre(612, 794, 265, 334, 6, 140, 936, 566));
+  EXPECT_THAT(DrawIndexes(philox, 8), ElementsAre(603, 268, 984, 83, 346, 435, 897, 463));
+}
+
+TEST(RandomPlacementGeneratorTest, ReseedingRepeatsTheNumbers) {
+  for (const RandomEngine engine : { RandomEngine::MersenneTwister, RandomEngine::Philox }) {
+    RandomPlacementGenerator placement_generator(7, engine);
+    const std::vector<int> first = DrawIndexes(placement_generator, 64);
+
+    placement_generator.Seed(7);
+    EXPECT_EQ(first, DrawIndexes(placement_generator, 64));
+
+    placement_generator.Seed(7, 1);
+    EXPECT_NE(first, DrawIndexes(placement_generator, 64));
+  }
+}
+
+TEST(RandomPlacementGeneratorTest, DiscardSkipsTheSameAsDrawing) {
+  for (const RandomEngine engine : { RandomEngine::MersenneTwister, RandomEngine::Philox }) {
+    RandomPlacementGenerator drawn(11, engine);
+    RandomPlacementGenerator skipped(11, engine);
+
+    // A range of 1024 never redraws, so each index takes exactly one number.
+    for (int draw = 0; draw < 1001; ++draw) {
+      drawn.ChooseIndex(1024);
+    }
+
+    skipped.Discard(1001);
+
+    EXPECT_EQ(DrawIndexes(drawn, 16), DrawIndexes(skipped, 16));
+  }
+}
+
+TEST(RandomPlacementGeneratorTest, IndexesStayInRange) {
+  RandomPlacementGenerator placement_generator(3, RandomEngine::Philox);
+  std::vector<int> counts(3);
+
+  for (int draw = 0; draw < 3000; ++draw) {
+    const int index = placement_generator.ChooseIndex(3);
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, 3);
+    ++counts[index];
+  }
+
+  for (const int count : counts) {
+    EXPECT_GT(count, 900);
+  }
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server/session-server.h"
+#include "test-configurations.h"
+
+std::string TestSocketPath() {
+  return "/tmp/session-server-test-" + std::to_string(getpid()) + ".sock";
+}
+
+int ConnectClient(const std::string& socket_path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+  const int client = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    close(client);
+    return -1;
+  }
+
+  return client;
+}
+
+void SendText(const int client, const std::string& text) {
+  ASSERT_EQ(static_cast<ssize_t>(text.size()), send(client, text.data(), text.size(), 0));
+}
+
+// Reads until the server has answered line_count commands, i.e. sent that many OK or ERR lines,
+// or has closed the connection.
+std::string ReceiveReplies(const int client, const int line_count) {
+  std::string text;
+  int replies = 0;
+  char buffer[4096];
+
+  while (replies < line_count) {
+    const ssize_t size = recv(client, buffer, sizeof(buffer), 0);
+
+    if (size <= 0) {
+      break;
+    }
+
+    text.append(buffer, size);
+    replies = 0;
+
+    for (std::size_t start = 0; start < text.size();) {
+      const std::size_t end = text.find('\n', start);
+
+      if (end == std::string::npos) {
+        break;
+      }
+
+      const std::string line = text.substr(start, end - start);
+
+      if ((line == "OK") || (line.rfind("ERR ", 0) == 0)) {
+        ++replies;
+      }
+
+      start = end + 1;
+    }
+  }
+
+  return text;
+}
+
+TEST(SessionServerTest, ServesIndependentSessions) {
+  const Configuration configuration = TwoShipTestConfiguration();
+  const std::string socket_path = TestSocketPath();
+  SessionServer server(configuration, socket_path, 2);
+
+  ASSERT_TRUE(server.Listen());
+  std::thread server_thread(&SessionServer::Run, &server);
+
+  const int first_client = ConnectClient(socket_path);
+  const int second_client = ConnectClient(socket_path);
+  ASSERT_GE(first_client, 0);
+  ASSERT_GE(second_client, 0);
+
+  // Several commands in one write are all answered, in order.
+  SendText(first_client, "PLACE 1 h A1\nSHIPS\n");
+  SendText(second_client, "SHIPS\n");
+
+  EXPECT_EQ("OK\n1 5 placed Carrier\n2 2 unplaced Patrol Boat\nOK\n",
+            ReceiveReplies(first_client, 2));
+  EXPECT_EQ("1 5 unplaced Carrier\n2 2 unplaced Patrol Boat\nOK\n",
+            ReceiveReplies(second_client, 1));
+
+  SendText(first_client, "QUIT\n");
+  EXPECT_EQ("OK\n", ReceiveReplies(first_client, 1));
+  // The server hangs up once the session has ended.
+  EXPECT_EQ("", ReceiveReplies(first_client, 1));
+
+  close(first_client);
+  close(second_client);
+  server.Stop();
+  server_thread.join();
+}
+
+TEST(SessionServerTest, AnswersLinesSentBeforeTheClientStopsWriting) {
+  const Configuration configuration = TwoShipTestConfiguration();
+  const std::string socket_path = TestSocketPath();
+  SessionServer server(configuration, socket_path, 1);
+
+  ASSERT_TRUE(server.Listen());
+  std::thread server_thread(&SessionServer::Run, &server);
+
+  const int client = ConnectClient(socket_path);
+  ASSERT_GE(client, 0);
+
+  std::string commands;
+
+  // More lines than the server keeps pending at once.
+  for (int line = 0; line < 3 * SessionServer::max_pending_lines; ++line) {
+    commands += "HELLO\n";
+  }
+
+  SendText(client, commands);
+  shutdown(client, SHUT_WR);
+
+  const std::string replies = ReceiveReplies(client, 3 * SessionServer::max_pending_lines);
+  std::string expected;
+
+  for (int line = 0; line < 3 * SessionServer::max_pending_lines; ++line) {
+    expected += "ERR unknown command\n";
+  }
+
+  EXPECT_EQ(expected, replies);
+
+  close(client);
+  server.Stop();
+  server_thread.join();
+}
+
+TEST(SessionServerTest, ClosesConnectionsSendingTooLongALine) {
+  const Configuration configuration = TwoShipTestConfiguration();
+  const std::string socket_path = TestSocketPath();
+  SessionServer server(configuration, socket_path, 1);
+
+  ASSERT_TRUE(server.Listen());
+  std::thread server_thread(&SessionServer::Run, &server);
+
+  const int client = ConnectClient(socket_path);
+  ASSERT_GE(client, 0);
+
+  // The long line is complete, so it arrives in one read together with the lines around it.
+  SendText(client, "HELLO\n" + std::string(SessionServer::max_line_length + 1, 'A') +
+                       "\nHELLO\n");
+
+  EXPECT_EQ("ERR unknown command\nERR line too long\n", ReceiveReplies(client, 3));
+
+  close(client);
+  server.Stop();
+  server_thread.join();
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "shared.h"
+
+TEST(CoordinateTest, FormatsEveryColumn) {
+  EXPECT_EQ("A", CoordinateLetters(1));
+  EXPECT_EQ("Z", CoordinateLetters(26));
+  EXPECT_EQ("AA", CoordinateLetters(27));
+  EXPECT_EQ("CB", CoordinateLetters(80));
+  EXPECT_TRUE(CoordinateLetters(0).empty());
+  EXPECT_TRUE(CoordinateLetters(81).empty());
+
+  for (int column = 1; column <= max_coordinate; ++column) {
+    EXPECT_EQ(CoordinateToLetter(column), CoordinateLetters(column));
+  }
+}
+
+TEST(CoordinateTest, LettersRoundTrip) {
+  for (int column = 1; column <= max_coordinate; ++column) {
+    int parsed_column = 0;
+
+    ASSERT_EQ(CoordinateError::None,
+              ParseCoordinateLetters(CoordinateLetters(column), parsed_column));
+    EXPECT_EQ(column, parsed_column);
+  }
+}
+
+TEST(CoordinateTest, ParsesEitherOrder) {
+  Coordinate coordinate;
+
+  ASSERT_EQ(CoordinateError::None, ParseCoordinate("A2", coordinate));
+  EXPECT_EQ(1, coordinate.column);
+  EXPECT_EQ(2, coordinate.row);
+
+  ASSERT_EQ(CoordinateError::None, ParseCoordinate("12ab", coordinate));
+  EXPECT_EQ(28, coordinate.column);
+  EXPECT_EQ(12, coordinate.row);
+
+  ASSERT_EQ(CoordinateError::None, ParseCoordinate("AB12", coordinate));
+  EXPECT_EQ(28, coordinate.column);
+  EXPECT_EQ(12, coordinate.row);
+}
+
+TEST(CoordinateTest, RejectsInvalidInput) {
+  Coordinate coordinate;
+
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("A", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("ABC1", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("A123", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("A1B", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("1A2", coordinate));
+  EXPECT_EQ(CoordinateError::InvalidFormat, ParseCoordinate("A 2", coordinate));
+  EXPECT_EQ(CoordinateError::ColumnOutOfRange, ParseCoordinate("CC1", coordinate));
+  EXPECT_EQ(CoordinateError::RowOutOfRange, ParseCoordinate("A0", coordinate));
+  EXPECT_EQ(CoordinateError::RowOutOfRange, ParseCoordinate("81A", coordinate));
+
+  EXPECT_EQ(0, coordinate.column);
+  EXPECT_EQ(0, coordinate.row);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "target-heatmap.h"
+
+TEST(TargetHeatmapTest, CentreIsHottestOnEmptyBoard) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  TargetHeatmap heatmap(board);
+
+  // Horizontal and vertical windows of a 3 cell ship covering each corner and the centre.
+  EXPECT_EQ(2, heatmap.GetHeat(BoardLetterIndex(A, 1)));
+  EXPECT_EQ(6, heatmap.GetHeat(BoardLetterIndex(C, 3)));
+
+  const std::vector<Location> hottest = heatmap.HottestLocations();
+
+  ASSERT_EQ(1, hottest.size());
+  EXPECT_EQ(BoardLetterIndex(C, 3), hottest.front());
+}
+
+TEST(TargetHeatmapTest, MissesRemoveWindowsThroughThem) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Submarine", 3 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  TargetHeatmap heatmap(board);
+
+  board.Shoot(BoardLetterIndex(C, 3));
+  heatmap.RecordShot(BoardLetterIndex(C, 3));
+
+  EXPECT_EQ(0, heatmap.GetHeat(BoardLetterIndex(C, 3)));
+  // B3 loses the horizontal windows A3-C3 and B3-D3, keeping its three vertical ones.
+  EXPECT_EQ(3, heatmap.GetHeat(BoardLetterIndex(B, 3)));
+  EXPECT_EQ(2, heatmap.GetHeat(BoardLetterIndex(A, 1)));
+}
+
+TEST(TargetHeatmapTest, IncrementalUpdatesMatchFreshHeatmap) {
+  Board board(10, 10);
+  board.AddBoat(ShipType{ "Carrier", 5 }, BoardLetterIndex(A, 1), Orientation::Vertical);
+  board.AddBoat(ShipType{ "Destroyer", 3 }, BoardLetterIndex(C, 5), Orientation::Horizontal);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(H, 9), Orientation::Vertical);
+  board.AddMine(BoardLetterIndex(F, 6));
+  TargetHeatmap heatmap(board);
+
+  const std::vector<Location> shots = { BoardLetterIndex(B, 2), BoardLetterIndex(F, 6),
+                                        BoardLetterIndex(C, 5), BoardLetterIndex(D, 5),
+                                        BoardLetterIndex(E, 5), BoardLetterIndex(J, 10),
+                                        BoardLetterIndex(H, 2) };
+
+  for (const Location shot : shots) {
+    board.Shoot(shot);
+    heatmap.RecordShots(board.GetLastShotCells());
+    heatmap.UpdateRemainingShips();
+  }
+
+  const TargetHeatmap fresh_heatmap(board);
+
+  for (int x = 1; x <= 10; ++x) {
+    for (int y = 1; y <= 10; ++y) {
+      EXPECT_EQ(fresh_heatmap.GetHeat(Location(x, y)), heatmap.GetHeat(Location(x, y)));
+    }
+  }
+}
+
+TEST(TargetHeatmapTest, SunkShipsStopContributing) {
+  Board board(5, 5);
+  board.AddBoat(ShipType{ "Patrol Boat", 2 }, BoardLetterIndex(A, 1), Orientation::Horizontal);
+  TargetHeatmap heatmap(board);
+
+  board.Shoot(BoardLetterIndex(A, 1));
+  board.Shoot(BoardLetterIndex(B, 1));
+  heatmap.RecordShot(BoardLetterIndex(A, 1));
+  heatmap.RecordShot(BoardLetterIndex(B, 1));
+  heatmap.UpdateRemainingShips();
+
+  EXPECT_EQ(0, heatmap.GetHeat(BoardLetterIndex(C, 3)));
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "terminal/terminal-output.h"
+
+TEST(TerminalOutputTest, FirstFrameRedrawsWholeScreen) {
+  TerminalOutput terminal_output;
+  terminal_output.Write("Please choose:\n[0]: ");
+
+  EXPECT_EQ("\033[H\033[2JPlease choose:\n[0]: ", terminal_output.ComposeUpdate(24, 80));
+}
+
+TEST(TerminalOutputTest, OnlyChangedLinesAreRedrawn) {
+  TerminalOutput terminal_output;
+  terminal_output.Write("A B\n1 X\n2  \n[1]: ");
+  terminal_output.ComposeUpdate(24, 80);
+  terminal_output.EchoInput("B2");
+
+  terminal_output.Clear();
+  terminal_output.Write("A B\n1 X\n2   ●\n[1]: ");
+
+  EXPECT_EQ("\033[3;1H2   ●\033[K"
+            "\033[4;1H[1]: \033[K"
+            "\033[5;1H\033[J"
+            "\033[4;6H", terminal_output.ComposeUpdate(24, 80));
+}
+
+TEST(TerminalOutputTest, UnchangedFrameOnlyMovesCursor) {
+  TerminalOutput terminal_output;
+  terminal_output.Write("Board\n[0]: ");
+  terminal_output.ComposeUpdate(24, 80);
+
+  terminal_output.Clear();
+  terminal_output.Write("Board\n[0]: ");
+
+  EXPECT_EQ("\033[2;6H", terminal_output.ComposeUpdate(24, 80));
+}
+
+TEST(TerminalOutputTest, FrameTooBigForTerminalRedrawsWholeScreen) {
+  TerminalOutput terminal_output;
+  terminal_output.Write("1\n2\n3");
+  terminal_output.ComposeUpdate(24, 80);
+
+  terminal_output.Clear();
+  terminal_output.Write("1\n2\n3\n4");
+
+  EXPECT_EQ("\033[H\033[2J1\n2\n3\n4", terminal_output.ComposeUpdate(3, 80));
+}
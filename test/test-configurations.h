@@ -0,0 +1,30 @@
+#ifndef TEST_TEST_CONFIGURATIONS_H
+#define TEST_TEST_CONFIGURATIONS_H
+
+#include "configuration/configuration.h"
+
+// The standard fleet of five ships on a 10x10 board.
+inline Configuration DefaultTestConfiguration() {
+  Configuration configuration;
+  configuration.board_width = 10;
+  configuration.board_height = 10;
+  configuration.ship_types.emplace_back(ShipType{ "Carrier", 5 });
+  configuration.ship_types.emplace_back(ShipType{ "Battleship", 4 });
+  configuration.ship_types.emplace_back(ShipType{ "Destroyer", 3 });
+  configuration.ship_types.emplace_back(ShipType{ "Submarine", 3 });
+  configuration.ship_types.emplace_back(ShipType{ "Patrol Boat", 2 });
+  return configuration;
+}
+
+// Just the largest and smallest ships of the standard fleet on a 10x10 board, for tests that list
+// the whole fleet.
+inline Configuration TwoShipTestConfiguration() {
+  Configuration configuration;
+  configuration.board_width = 10;
+  configuration.board_height = 10;
+  configuration.ship_types.emplace_back(ShipType{ "Carrier", 5 });
+  configuration.ship_types.emplace_back(ShipType{ "Patrol Boat", 2 });
+  return configuration;
+}
+
+#endif // TEST_TEST_CONFIGURATIONS_H
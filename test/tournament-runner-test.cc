@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "simulation/tournament-runner.h"
+#include "test-configurations.h"
+
+TEST(TournamentRunnerTest, PlaysEveryGame) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const TournamentRunner tournament_runner(configuration, 42, 4);
+
+  const TournamentResult result = tournament_runner.Run(300, NORMAL);
+
+  ASSERT_EQ(300, result.games.size());
+  EXPECT_EQ(300, result.wins[0] + result.wins[1]);
+
+  std::int64_t total_shots_to_win = 0;
+
+  for (const GameStatistics& game : result.games) {
+    EXPECT_NE(0, game.winner);
+    total_shots_to_win += game.shots_to_win;
+  }
+
+  EXPECT_EQ(total_shots_to_win, result.total_shots_to_win);
+}
+
+TEST(TournamentRunnerTest, SameSeedGivesSameResultsForAnyThreadCount) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const TournamentRunner single_thread_runner(configuration, 1234, 1);
+  const TournamentRunner multi_thread_runner(configuration, 1234, 8);
+
+  const TournamentResult single_thread_result = single_thread_runner.Run(500, SALVO);
+  const TournamentResult multi_thread_result = multi_thread_runner.Run(500, SALVO);
+
+  ASSERT_EQ(single_thread_result.games.size(), multi_thread_result.games.size());
+  EXPECT_EQ(single_thread_result.wins, multi_thread_result.wins);
+  EXPECT_EQ(single_thread_result.total_shots_to_win, multi_thread_result.total_shots_to_win);
+
+  for (int game = 0; game < static_cast<int>(single_thread_result.games.size()); ++game) {
+    EXPECT_EQ(single_thread_result.games[game].winner, multi_thread_result.games[game].winner);
+    EXPECT_EQ(single_thread_result.games[game].turns, multi_thread_result.games[game].turns);
+  }
+}
+
+TEST(TournamentRunnerTest, DifferentSeedsGiveDifferentGames) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const TournamentRunner runner_1(configuration, 1, 2);
+  const TournamentRunner runner_2(configuration, 2, 2);
+
+  const TournamentResult result_1 = runner_1.Run(200, NORMAL);
+  const TournamentResult result_2 = runner_2.Run(200, NORMAL);
+
+  EXPECT_NE(result_1.total_shots_to_win, result_2.total_shots_to_win);
+}
+
+TEST(TournamentRunnerTest, DefaultsToAtLeastOneThread) {
+  const Configuration configuration = DefaultTestConfiguration();
+  const TournamentRunner tournament_runner(configuration, 0);
+
+  EXPECT_GE(tournament_runner.GetThreadCount(), 1);
+  EXPECT_TRUE(tournament_runner.Run(0, NORMAL).games.empty());
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "profiling/tracer.h"
+
+int CountOccurrences(const std::string& text, const std::string& pattern) {
+  int count = 0;
+
+  for (std::size_t position = text.find(pattern); position != std::string::npos;
+       position = text.find(pattern, position + 1)) {
+    ++count;
+  }
+
+  return count;
+}
+
+TEST(TracerTest, SpansAreOnlyRecordedWhileTracing) {
+  ClearTrace();
+
+  {
+    TRACE_SPAN("Untraced");
+  }
+
+  StartTracing();
+
+  {
+    TRACE_SPAN("Outer");
+    TRACE_SPAN("Inner");
+  }
+
+  std::thread worker([] {
+    TRACE_SPAN("Worker");
+  });
+  worker.join();
+
+  StopTracing();
+
+  const std::string trace = FormatChromeTrace();
+  EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  EXPECT_EQ(0, CountOccurrences(trace, "Untraced"));
+  EXPECT_EQ(1, CountOccurrences(trace, "{\"name\":\"Outer\",\"ph\":\"X\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"Inner\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"Worker\""));
+  EXPECT_EQ(3, CountOccurrences(trace, "\"pid\":1"));
+
+  ClearTrace();
+}
+
+TEST(TracerTest, FullRingKeepsTheLatestSpans) {
+  ClearTrace();
+
+  for (int span = 0; span < trace_ring_capacity; ++span) {
+    RecordTraceSpan("Old", span, 1);
+  }
+
+  RecordTraceSpan("New", trace_ring_capacity, 1);
+
+  const std::string trace = FormatChromeTrace();
+  EXPECT_EQ(trace_ring_capacity - 2, CountOccurrences(trace, "\"Old\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"New\""));
+
+  ClearTrace();
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "board/random-placement-generator.h"
+#include "board/window-counts.h"
+
+// Checks every window position one cell at a time.
+std::vector<int> CountOpenWindowsOneByOne(const BitPlane& blocked, const int width,
+                                          const int height, const int length) {
+  std::vector<int> counts(width * height, 0);
+
+  const auto add_window = [&](const int x, const int y, const int step_x, const int step_y) {
+    for (int offset = 0; offset < length; ++offset) {
+      if ((x + (offset * step_x) > width) || (y + (offset * step_y) > height) ||
+          blocked.Test(x + (offset * step_x), y + (offset * step_y))) {
+        return;
+      }
+    }
+
+    for (int offset = 0; offset < length; ++offset) {
+      ++counts[((y + (offset * step_y) - 1) * width) + (x + (offset * step_x) - 1)];
+    }
+  };
+
+  for (int y = 1; y <= height; ++y) {
+    for (int x = 1; x <= width; ++x) {
+      add_window(x, y, 1, 0);
+
+      if (length > 1) {
+        add_window(x, y, 0, 1);
+      }
+    }
+  }
+
+  return counts;
+}
+
+TEST(WindowCountsTest, CountsWindowsOnOpenBoard) {
+  BitPlane blocked;
+  std::vector<int> counts;
+
+  CountOpenWindows(blocked, blocked, 5, 5, 3, counts, WindowCountKernel::Scalar);
+
+  ASSERT_EQ(25, counts.size());
+  EXPECT_EQ(2, counts[0]);
+  EXPECT_EQ(6, counts[12]);
+}
+
+TEST(WindowCountsTest, TransposeSwapsRowsAndColumns) {
+  BitPlane plane;
+  plane.Set(3, 7);
+
+  const BitPlane transposed = TransposeBitPlane(plane, 10, 10);
+
+  EXPECT_TRUE(transposed.Test(7, 3));
+  EXPECT_FALSE(transposed.Test(3, 7));
+}
+
+TEST(WindowCountsTest, KernelsMatchWindowByWindowCounts) {
+  RandomPlacementGenerator placement_generator(5);
+
+  for (const WindowCountKernel kernel : { WindowCountKernel::Scalar, WindowCountKernel::Avx2 }) {
+    if (!IsWindowCountKernelSupported(kernel)) {
+      continue;
+    }
+
+    // Sizes either side of the 64 cell word boundary, and lines that don't fill four lanes.
+    for (const auto& [width, height] : { std::pair(10, 10), std::pair(7, 13), std::pair(64, 65),
+                                         std::pair(80, 80), std::pair(80, 3) }) {
+      BitPlane blocked;
+
+      for (int miss = 0; miss < (width * height) / 8; ++miss) {
+        const Location location = placement_generator.GenerateLocation(width, height);
+        blocked.Set(location.x, location.y);
+      }
+
+      const BitPlane blocked_columns = TransposeBitPlane(blocked, width, height);
+
+      for (const int length : { 1, 2, 5, 9, 70, 81 }) {
+        std::vector<int> counts;
+        CountOpenWindows(blocked, blocked_columns, width, height, length, counts, kernel);
+
+        EXPECT_EQ(CountOpenWindowsOneByOne(blocked, width, height, length), counts)
+            << width << "x" << height << " length " << length;
+      }
+    }
+  }
+}